@@ -13,10 +13,10 @@ void Action::start(GameTime gameTime) { _timeStarted = gameTime; }
 
 void Action::finish(GameTime gameTime) { 
 	if (_actor->isMoving()) {
-		_actor->setNextAction(new MoveAction(_actor));
+		_actor->setNextAction<MoveAction>();
 	}
 	else {
-		_actor->setNextAction(new IdleAction(_actor)); 
+		_actor->setNextAction<IdleAction>();
 	}
 }
 
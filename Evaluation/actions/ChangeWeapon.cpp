@@ -1,7 +1,9 @@
 #include "ChangeWeapon.h"
 #include "entities/Actor.h"
+#include "engine/MissileManager.h"
 
-ChangeWeaponAction::ChangeWeaponAction(Actor* actor, const String& weaponName) : Action(actor), _weaponName(weaponName) {}
+ChangeWeaponAction::ChangeWeaponAction(Actor* actor, const String& weaponName)
+	: Action(actor), _weaponId(MissileManager::getWeaponId(weaponName)) {}
 
 ChangeWeaponAction::~ChangeWeaponAction() {}
 
@@ -10,10 +12,12 @@ ActionType ChangeWeaponAction::getActionType() const { return ActionType::CHANGE
 bool ChangeWeaponAction::isTransactional() const { return true; }
 
 void ChangeWeaponAction::finish(GameTime gameTime) {
-	getActor()->setCurrentWeapon(_weaponName);
+	if (_weaponId != MissileManager::NULL_WEAPON_ID) {
+		getActor()->setCurrentWeapon(_weaponId);
+	}
 	Action::finish(gameTime);
 }
 
 bool ChangeWeaponAction::update(GameTime gameTime) {
-	return gameTime - getTimeStarted() > Config.WeaponChangeTime || getActor()->getCurrentWeapon() == _weaponName;
+	return gameTime - getTimeStarted() > Config.WeaponChangeTime || getActor()->getCurrentWeaponId() == _weaponId;
 }
@@ -12,5 +12,5 @@ public:
 	bool update(GameTime gameTime) override;
 
 private:
-	String _weaponName;
+	int _weaponId;
 };
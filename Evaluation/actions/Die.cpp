@@ -8,7 +8,7 @@ DieAction::~DieAction() {}
 
 void DieAction::finish(GameTime gameTime) { 
 	Actor* actor = getActor();
-	actor->setNextAction(new DeadAction(actor));
+	actor->setNextAction<DeadAction>();
 }
 
 bool DieAction::update(GameTime gameTime) { return gameTime - getTimeStarted() > Config.ActorDyingTime * SDL_GetPerformanceFrequency(); }
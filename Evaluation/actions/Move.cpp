@@ -1,12 +1,19 @@
 #include "Move.h"
 #include "entities/Actor.h"
 #include "main/Game.h"
+#include "engine/PathService.h"
 
-MoveAction::MoveAction(Actor* actor) : Action(actor), _pathplanning(false) {}
+MoveAction::MoveAction(Actor* actor) : Action(actor), _pathplanning(false), _useFlowField(false) {}
 
-MoveAction::MoveAction(Actor* actor, const Vector2& position) : Action(actor), _position(position), _pathplanning(true) {}
+MoveAction::MoveAction(Actor* actor, const Vector2& position, bool useFlowField)
+	: Action(actor), _position(position), _pathplanning(true), _useFlowField(useFlowField) {}
 
-MoveAction::~MoveAction() {}
+MoveAction::~MoveAction() {
+	// Zastpienie akcji przed otrzymaniem cieki anuluje zlecenie.
+	if (_pathRequest != nullptr) {
+		_pathRequest->cancel();
+	}
+}
 
 ActionType MoveAction::getActionType() const { return ActionType::MOVE; }
 
@@ -19,7 +26,12 @@ bool MoveAction::update(GameTime gameTime) {
 void MoveAction::start(GameTime gameTime) {
 	if (_pathplanning) {
 		Actor* actor = getActor();
-		actor->move(Game::getInstance()->getMap()->findPath(actor->getPosition(), _position, actor));
+		if (_useFlowField) {
+			actor->moveAlongFlowField(_position);
+		}
+		else {
+			_pathRequest = actor->moveTo(_position);
+		}
 		_pathplanning = false;
 	}
 	Action::start(gameTime);
@@ -55,7 +67,7 @@ void WanderAction::start(GameTime gameTime) {
 	Actor* actor = getActor();
 	actor->stop();
 	_center = actor->getPosition();
-	Logger::log("Actor " + actor->getName() + " started wandering.");
+	LOG(LOG_INFO, LOG_ACTIONS, "Actor " + actor->getName() + " started wandering.");
 	Action::start(gameTime);
 }
 
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <memory>
 #include "Action.h"
 
+class PathRequest;
+
 class MoveAction : public Action {
 public:
 	MoveAction(Actor* actor);
-	MoveAction(Actor* actor, const Vector2& position);
+	MoveAction(Actor* actor, const Vector2& position, bool useFlowField = false);
 	~MoveAction();
 	ActionType getActionType() const override;
 	bool isTransactional() const override;
@@ -15,6 +18,8 @@ public:
 private:
 	Vector2 _position;
 	bool _pathplanning;
+	bool _useFlowField;
+	std::shared_ptr<PathRequest> _pathRequest;
 };
 
 class MoveAtAction : public Action {
@@ -15,18 +15,24 @@ void ShootAction::start(GameTime gameTime) {
 
 void ShootAction::finish(GameTime gameTime) {
 	Actor* actor = getActor();
-	WeaponState& weaponState = actor->getWeaponState(actor->getCurrentWeapon());
-	weaponState.state = WeaponLoadState::WEAPON_UNLOADED;
-	weaponState.lastShot = gameTime;
+	int weaponId = actor->getCurrentWeaponId();
+	if (weaponId != MissileManager::NULL_WEAPON_ID) {
+		actor->unloadWeapon(weaponId, gameTime);
+	}
 	Action::finish(gameTime);
 }
 
 bool ShootAction::update(GameTime gameTime) {
 	Actor* actor = getActor();
 
-	String currentWeapon = actor->getCurrentWeapon();
-	WeaponState& weaponState = actor->getWeaponState(currentWeapon);
-	const WeaponInfo& weaponInfo = getWeaponInfo(currentWeapon);
+	int weaponId = actor->getCurrentWeaponId();
+	if (weaponId == MissileManager::NULL_WEAPON_ID) {
+		LOG(LOG_WARNING, LOG_COMBAT, "Actor " + actor->getName() + " tried to shoot an unknown weapon " + actor->getCurrentWeapon() + ".");
+		return true;
+	}
+
+	WeaponState& weaponState = actor->getWeaponState(weaponId);
+	const WeaponInfo& weaponInfo = MissileManager::getWeaponInfo(weaponId);
 	bool shotFailed = false;
 
 	actor->lookAt(_target);
@@ -38,7 +44,7 @@ bool ShootAction::update(GameTime gameTime) {
 		if (weaponState.ammo > 0) {
 			if (weaponState.state != WeaponLoadState::WEAPON_UNLOADED) {
 				if (_shots == 0) {
-					Logger::log("Actor " + actor->getName() + " shot a " + weaponInfo.name + ".");
+					LOG(LOG_INFO, LOG_COMBAT, "Actor " + actor->getName() + " shot a " + weaponInfo.name + ".");
 				}
 				++_shots;
 				_nextShotTime = gameTime + weaponInfo.shotTime;
@@ -49,12 +55,12 @@ bool ShootAction::update(GameTime gameTime) {
 			}
 			else {
 				shotFailed = true;
-				Logger::log("Actor " + actor->getName() + " tried to shoot a " + weaponInfo.name + " but it's not loaded.");
+				LOG(LOG_WARNING, LOG_COMBAT, "Actor " + actor->getName() + " tried to shoot a " + weaponInfo.name + " but it's not loaded.");
 			}
 		}
 		else {
 			shotFailed = true;
-			Logger::log("Actor " + actor->getName() + " tried to shoot a " + weaponInfo.name + " but it has no ammo left.");
+			LOG(LOG_WARNING, LOG_COMBAT, "Actor " + actor->getName() + " tried to shoot a " + weaponInfo.name + " but it has no ammo left.");
 		}
 	}
 	else if (_nextShotTime == 0 && common::abs(common::measureAngle(actor->getOrientation(),
@@ -3,6 +3,7 @@
 #include "agents/ObjectInfo.h"
 #include "agents/ActorKnowledge.h"
 #include "main/Game.h"
+#include "engine/MissileManager.h"
 
 ActorKnowledge::ActorKnowledge(Actor* actor) : _actor(actor) {}
 ActorKnowledge::~ActorKnowledge() {}
@@ -17,8 +18,14 @@ float ActorKnowledge::getOrientation() const { return _actor->getOrientation();
 int ActorKnowledge::getHealth() const { return _actor->getHealth(); }
 int ActorKnowledge::getArmor() const { return _actor->getArmor(); }
 String ActorKnowledge::getWeaponType() const { return _actor->getCurrentWeapon(); }
-int ActorKnowledge::getAmmo(const String& weaponName) const { return _actor->getWeaponState(weaponName).ammo; }
-bool ActorKnowledge::isLoaded(const String& weaponName) const { return _actor->getWeaponState(weaponName).state == WeaponLoadState::WEAPON_LOADED; }
+int ActorKnowledge::getAmmo(const String& weaponName) const {
+	int weaponId = MissileManager::getWeaponId(weaponName);
+	return weaponId == MissileManager::NULL_WEAPON_ID ? 0 : _actor->getWeaponState(weaponId).ammo;
+}
+bool ActorKnowledge::isLoaded(const String& weaponName) const {
+	int weaponId = MissileManager::getWeaponId(weaponName);
+	return weaponId != MissileManager::NULL_WEAPON_ID && _actor->getWeaponState(weaponId).state == WeaponLoadState::WEAPON_LOADED;
+}
 Vector2 ActorKnowledge::getVelocity() const { return _actor->getVelocity(); }
 float ActorKnowledge::getEstimatedRemainingDistance() const { return _actor->estimateRemainingDistance(); }
 Vector2 ActorKnowledge::getShortDestination() const { return _actor->getShortGoal(); }
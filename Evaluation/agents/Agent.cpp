@@ -15,7 +15,7 @@
 
 void Agent::initialize(GameTime time) {
 	initializeLogic(ActorKnowledge(_actor), time);
-	_actor->setCurrentAction(new IdleAction(_actor));
+	_actor->setCurrentAction<IdleAction>();
 	_totalFrames = 0;
 }
 
@@ -32,7 +32,7 @@ void Agent::run(GameTime time) {
 	_hasStarted = true;
 	initializeLogic(ActorKnowledge(_actor), time);
 	_thread = std::thread(&Agent::runFunc, this);
-	_actor->setCurrentAction(new IdleAction(_actor));
+	_actor->setCurrentAction<IdleAction>();
 	_totalFrames = 0;
 }
 
@@ -129,39 +129,34 @@ void Agent::removeNotificationSender(NotificationSender* sender) {
 	}
 }
 
-bool Agent::trySetAction(Action* action) {
-	if (!_actor->setCurrentAction(action)) {
-		delete action;
-		return false;
-	}
-	return true;
-}
-
 Agent::Agent(Actor* actor) : _actor(actor), _hasStarted(false) {}
 
 Actor* Agent::getActor() { return _actor; }
 const Actor* Agent::getActor() const { return _actor; }
 
 void Agent::selectWeapon(const String& weaponName) {
-	trySetAction(new ChangeWeaponAction(_actor, weaponName));
+	_actor->setCurrentAction<ChangeWeaponAction>(weaponName);
 }
 void Agent::move(const Vector2& target) {
-	trySetAction(new MoveAction(_actor, target));
+	_actor->setCurrentAction<MoveAction>(target);
+}
+void Agent::moveAlongFlowField(const Vector2& target) {
+	_actor->setCurrentAction<MoveAction>(target, true);
 }
 void Agent::face(const Vector2& target) {
-	trySetAction(new FaceAction(_actor, target));
+	_actor->setCurrentAction<FaceAction>(target);
 }
 void Agent::shoot(const Vector2& target) {
-	trySetAction(new ShootAction(_actor, target));
+	_actor->setCurrentAction<ShootAction>(target);
 }
 void Agent::wait() {
-	trySetAction(new IdleAction(_actor));
+	_actor->setCurrentAction<IdleAction>();
 }
 void Agent::moveDirection(const Vector2& direction) {
-	trySetAction(new MoveAtAction(_actor, direction));
+	_actor->setCurrentAction<MoveAtAction>(direction);
 }
 void Agent::wander() {
-	trySetAction(new WanderAction(_actor));
+	_actor->setCurrentAction<WanderAction>();
 }
 
 size_t Agent::getTotalFrames() const {
@@ -179,7 +174,8 @@ float Agent::getActorMaxArmor() const { return Config.MaxArmor; }
 float Agent::getActorMaxHealth() const { return Config.ActorMaxHealth; }
 
 float Agent::getMaxAmmo(const String& weaponName) const { 
-	return MissileManager::getWeaponInfo(weaponName).maxAmmo; 
+	int weaponId = MissileManager::getWeaponId(weaponName);
+	return weaponId != MissileManager::NULL_WEAPON_ID ? MissileManager::getWeaponInfo(weaponId).maxAmmo : 0;
 }
 
 float Agent::getActorRadius() const { return Config.ActorRadius; }
@@ -42,6 +42,8 @@ public:
 
 	void selectWeapon(const String& weaponName);
 	void move(const Vector2& target);
+	// Ruch z wykorzystaniem pola kierunkw wspdzielonego przez agentw zmierzajcych do tego samego celu.
+	void moveAlongFlowField(const Vector2& target);
 	void face(const Vector2& target);
 	void shoot(const Vector2& target);
 	void moveDirection(const Vector2& direction);
@@ -99,8 +101,6 @@ private:
 	std::vector<Notification> _notifications;
 	std::vector<ObjectInfo> _seenObjects;
 
-	bool trySetAction(Action* action);
-
 	friend class Game;
 };
 
@@ -92,6 +92,7 @@ inline LuaEnv* createLuaEnv() {
 		luabind::class_<LuaAgent>("LuaAgent")
 			.def("getName", &LuaAgent::getName)
 			.def("move", &LuaAgent::move)
+			.def("moveAlongFlowField", &LuaAgent::moveAlongFlowField)
 			.def("face", &LuaAgent::face)
 			.def("wait", &LuaAgent::wait)
 			.def("moveDirection", &LuaAgent::moveDirection)
@@ -6,10 +6,11 @@
 #include "entities/Actor.h"
 #include "ResourceManager.h"
 #include "engine/Camera.h"
+#include "engine/PrimitiveBatch.h"
 #include "entities/Team.h"
 
 Camera::Camera(int x, int y, int xMin, int xMax, int yMin, int yMax)
-	: _xMin(xMin), _xMax(xMax), _yMin(yMin), _yMax(yMax) {
+	: _xMin(xMin), _xMax(xMax), _yMin(yMin), _yMax(yMax), _viewWidth(Config.DisplayWidth), _viewHeight(Config.DisplayHeight) {
 	_x = x < xMin ? xMin : x > xMax ? xMax : x;
 	_y = y < yMin ? yMin : y > yMax ? yMax : y;
 	_speed = Config.CameraSpeed > 0 ? Config.CameraSpeed : 1;
@@ -52,6 +53,29 @@ int Camera::getX() const { return _x; }
 
 int Camera::getY() const { return _y; }
 
+void Camera::setViewSize(int width, int height) {
+	_viewWidth = width;
+	_viewHeight = height;
+}
+
+int Camera::getViewWidth() const { return _viewWidth; }
+
+int Camera::getViewHeight() const { return _viewHeight; }
+
+bool Camera::isVisible(const Vector2& center, float radius) const {
+	return center.x + radius >= _x && center.x - radius <= _x + _viewWidth
+		&& center.y + radius >= _y && center.y - radius <= _y + _viewHeight;
+}
+
+bool Camera::isVisible(const Segment& segment) const {
+	float left = segment.from.x, right = segment.to.x;
+	if (left > right) { common::swap(left, right); }
+	float top = segment.from.y, bottom = segment.to.y;
+	if (top > bottom) { common::swap(top, bottom); }
+	return right >= _x && left <= _x + _viewWidth
+		&& bottom >= _y && top <= _y + _viewHeight;
+}
+
 void drawTexture(SDL_Renderer* renderer, SDL_Texture* texture, const Vector2& position, const Camera& camera, PositionType positionType) {
 	int width, height;
 	SDL_QueryTexture(texture, nullptr, nullptr, &width, &height);
@@ -73,18 +97,31 @@ void drawTexture(SDL_Renderer* renderer, SDL_Texture* texture, const Vector2& ce
 }
 
 void drawString(SDL_Renderer* renderer, const char* string, int x, int y, const Camera& camera, PositionType positionType, bool centered, const SDL_Color& color) {
-	SDL_Surface* surfaceMessage = TTF_RenderText_Solid(ResourceManager::get()->getFont("mainfont"), string, color);
-	SDL_Texture* message = SDL_CreateTextureFromSurface(renderer, surfaceMessage);
-	int w = surfaceMessage->w, h = surfaceMessage->h;
-	SDL_Rect messageRect{ x, y, w, h };
+	const GlyphAtlas* atlas = ResourceManager::get()->getGlyphAtlas(renderer, "mainfont");
+	if (atlas == nullptr) { return; }
+	SDL_Rect messageRect{ x, y, centered ? atlas->getTextWidth(string) : 0, atlas->getHeight() };
 	if (centered) {
-		messageRect.x -= w / 2;
-		messageRect.y -= h / 2;
+		messageRect.x -= messageRect.w / 2;
+		messageRect.y -= messageRect.h / 2;
 	}
 	if (positionType == PositionType::Relative) { camera.adjustRenderArea(messageRect); }
-	SDL_RenderCopy(renderer, message, nullptr, &messageRect);
-	SDL_DestroyTexture(message);
-	SDL_FreeSurface(surfaceMessage);
+	atlas->draw(renderer, string, messageRect.x, messageRect.y, color);
+}
+
+void drawLabel(SDL_Renderer* renderer, const String& label, int x, int y, const Camera& camera, PositionType positionType, bool centered, const SDL_Color& color) {
+	SDL_Texture* texture = ResourceManager::get()->getLabel(renderer, "mainfont", label);
+	if (texture == nullptr) { return; }
+	int w, h;
+	SDL_QueryTexture(texture, nullptr, nullptr, &w, &h);
+	SDL_Rect labelRect{ x, y, w, h };
+	if (centered) {
+		labelRect.x -= w / 2;
+		labelRect.y -= h / 2;
+	}
+	if (positionType == PositionType::Relative) { camera.adjustRenderArea(labelRect); }
+	SDL_SetTextureColorMod(texture, color.r, color.g, color.b);
+	SDL_SetTextureAlphaMod(texture, color.a);
+	SDL_RenderCopy(renderer, texture, nullptr, &labelRect);
 }
 
 void drawAabb(SDL_Renderer* renderer, const Aabb& aabb, const Camera& camera, const SDL_Color& color) {
@@ -124,50 +161,35 @@ void drawCircle(SDL_Renderer* renderer, const Vector2& center, float radius, con
 	}
 }
 
+// Pojedyncze koo lub piercie rysowane s jednym wywoaniem SDL_RenderFillRects.
+static PrimitiveBatch immediateBatch;
+
 void fillCircle(SDL_Renderer* renderer, const Vector2& center, float radius, const Camera& camera, const SDL_Color& color) {
-	SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-	int x = int(center.x) - camera.getX(), y = int(center.y) - camera.getY(), r = int(radius), r2 = r * r;
-	for (int i = -r; i <= r; ++i) {
-		int t = sqrt(r2 - i * i);
-		SDL_RenderDrawLine(renderer, x - t, y + i, x + t, y + i);
-	}
+	immediateBatch.addCircle(center, radius, camera, color);
+	immediateBatch.flush(renderer);
 }
 
 void fillRing(SDL_Renderer* renderer, const Vector2& center, float radius1, float radius2, const Camera& camera, const SDL_Color& color) {
-	if (radius1 > radius2) { common::swap(radius1, radius2); }
-	SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-	int x = int(center.x) - camera.getX(), y = int(center.y) - camera.getY(), r1 = int(radius1), r12 = r1 * r1, r2 = int(radius2), r22 = r2 * r2;
-	for (int i = -r2; i <= r2; ++i) {
-		if (-r1 <= i && i <= r1) {
-			int t1 = sqrt(r12 - i * i);
-			int t2 = sqrt(r22 - i * i);
-			SDL_RenderDrawLine(renderer, x - t2, y + i, x - t1, y + i);
-			SDL_RenderDrawLine(renderer, x + t1, y + i, x + t2, y + i);
-		}
-		else {
-			int t = sqrt(r22 - i * i);
-			SDL_RenderDrawLine(renderer, x - t, y + i, x + t, y + i);
-		}
-	}
+	immediateBatch.addRing(center, radius1, radius2, camera, color);
+	immediateBatch.flush(renderer);
 }
 
 void drawTrigger(SDL_Renderer* renderer, const Trigger& trigger, const Camera& camera) {
 	try {
 		if (trigger.isActive()) {
-			SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, ResourceManager::get()->getImage(Config.TriggerRingTextureKey));
+			ResourceManager* resources = ResourceManager::get();
+			SDL_Texture* texture = resources->getTexture(renderer, Config.TriggerRingTextureKey);
 			drawTexture(renderer, texture, trigger.getPosition(), camera, Relative, trigger.getOrientation(), false);
-			SDL_DestroyTexture(texture);
 
 			TriggerType triggerType = trigger.getTriggerType();
 			String triggerKey = triggerType == TriggerType::HEALTH ? Config.MedPackTextureKey
 				: triggerType == TriggerType::ARMOR ? Config.ArmorPackTextureKey : Config.AmmoPackTextureKey;
 
-			texture = SDL_CreateTextureFromSurface(renderer, ResourceManager::get()->getImage(triggerKey));
+			texture = resources->getTexture(renderer, triggerKey);
 			drawTexture(renderer, texture, trigger.getPosition(), camera, Relative, 0, false);
-			SDL_DestroyTexture(texture);
 
 			Vector2 pos = trigger.getPosition();
-			drawString(renderer, trigger.getName().c_str(), pos.x, pos.y + Config.ActorNamePosition, camera, Relative, true, colors::white);
+			drawLabel(renderer, trigger.getName(), pos.x, pos.y + Config.ActorNamePosition, camera, Relative, true, colors::white);
 		}
 	}
 	catch (...) {}
@@ -181,19 +203,23 @@ SDL_Color blendColors(const SDL_Color& c1, const SDL_Color& c2, float t) {
 	return { r, g, b, a };
 }
 
-void drawActor(SDL_Renderer* renderer, const Actor& actor, const Camera& camera, bool isSelected, bool showHpBar) {
+void drawActorBody(PrimitiveBatch& batch, const Actor& actor, const Camera& camera, bool isSelected) {
+	if (!actor.isDead()) {
+		Vector2 actorPos = actor.getPosition();
+		batch.addCircle(actorPos, Config.ActorRadius, camera, actor.getTeam()->getColor());
+		if (isSelected) {
+			batch.addRing(actorPos, Config.ActorSelectionRing, Config.ActorSelectionRing + 1, camera, colors::green);
+		}
+	}
+}
+
+void drawActor(SDL_Renderer* renderer, const Actor& actor, const Camera& camera, bool showHpBar) {
 	try {
 		if (!actor.isDead()) {
-			SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, ResourceManager::get()->getImage(Config.ActorRingTextureKey));
+			SDL_Texture* texture = ResourceManager::get()->getTexture(renderer, Config.ActorRingTextureKey);
 			Vector2 actorPos = actor.getPosition();
-			fillCircle(renderer, actorPos, Config.ActorRadius, camera, actor.getTeam()->getColor());
-
-			if (isSelected) {
-				fillRing(renderer, actorPos, Config.ActorSelectionRing, Config.ActorSelectionRing + 1, camera, colors::green);
-			}
 
 			drawTexture(renderer, texture, actorPos, camera, Relative, actor.getOrientation(), false);
-			SDL_DestroyTexture(texture);
 
 			if (showHpBar) {
 				SDL_Rect rect = {
@@ -216,7 +242,7 @@ void drawActor(SDL_Renderer* renderer, const Actor& actor, const Camera& camera,
 				SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
 				SDL_RenderDrawRect(renderer, &rect);
 
-				drawString(renderer, actor.getName().c_str(), actorPos.x, actorPos.y + Config.ActorNamePosition, camera, Relative, true, 
+				drawLabel(renderer, actor.getName(), actorPos.x, actorPos.y + Config.ActorNamePosition, camera, Relative, true, 
 					/*actor.isWaiting() ? colors::red : actor.isMoving() ? colors::cyan : */colors::white);
 
 				++rect.x; ++rect.y;
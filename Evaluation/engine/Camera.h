@@ -1,3 +1,5 @@
+#include <string>
+
 struct SDL_Renderer;
 struct SDL_Texture;
 struct SDL_Color;
@@ -8,6 +10,7 @@ class Aabb;
 class Segment;
 class Trigger;
 class Actor;
+class PrimitiveBatch;
 
 enum PositionType {
 	Absolute,
@@ -27,6 +30,17 @@ public:
 	int getX() const;
 	int getY() const;
 
+	// Rozmiar widocznego obszaru, domylnie Config.DisplayWidth na Config.DisplayHeight. Powinien
+	// odpowiada rzeczywistemu rozmiarowi obszaru renderowania.
+	void setViewSize(int width, int height);
+	int getViewWidth() const;
+	int getViewHeight() const;
+
+	// Sprawdza, czy koo o podanym rodku i promieniu przecina widoczny obszar wiata.
+	bool isVisible(const Vector2& center, float radius) const;
+	// Sprawdza, czy prostokt otaczajcy odcinek przecina widoczny obszar wiata.
+	bool isVisible(const Segment& segment) const;
+
 private:
 	int _x;
 	int _y;
@@ -34,6 +48,8 @@ private:
 	int _xMax;
 	int _yMin;
 	int _yMax;
+	int _viewWidth;
+	int _viewHeight;
 	int _speed;
 };
 
@@ -45,6 +61,9 @@ void drawTexture(SDL_Renderer* renderer, SDL_Texture* texture, const Vector2& ce
 	const Camera& camera, PositionType positionType, float orientation, bool horizontalFlip);
 void drawString(SDL_Renderer* renderer, const char* string, int x, int y, const Camera& camera, 
 	PositionType positionType, bool centered, const SDL_Color& color);
+// Rysuje napis z zapamitanej tekstury. Przeznaczona dla napisw, ktre rzadko si zmieniaj.
+void drawLabel(SDL_Renderer* renderer, const std::string& label, int x, int y, const Camera& camera,
+	PositionType positionType, bool centered, const SDL_Color& color);
 
 void drawAabb(SDL_Renderer* renderer, const Aabb& aabb, const Camera& camera, const SDL_Color& color);
 void fillAabb(SDL_Renderer* renderer, const Aabb& aabb, const Camera& camera, const SDL_Color& color);
@@ -55,4 +74,7 @@ void fillCircle(SDL_Renderer* renderer, const Vector2& center, float radius, con
 void fillRing(SDL_Renderer* renderer, const Vector2& center, float radius1, float radius2, const Camera& camera, const SDL_Color& color);
 
 void drawTrigger(SDL_Renderer* renderer, const Trigger& trigger, const Camera& camera);
-void drawActor(SDL_Renderer* renderer, const Actor& actor, const Camera& camera, bool isSelected, bool showHpBar);
+// Dodaje do paczki prymityww ciao aktora i piercie zaznaczenia. Pozostae elementy aktora
+// rysuje drawActor, ktry naley wywoa po narysowaniu paczki.
+void drawActorBody(PrimitiveBatch& batch, const Actor& actor, const Camera& camera, bool isSelected);
+void drawActor(SDL_Renderer* renderer, const Actor& actor, const Camera& camera, bool showHpBar);
@@ -134,9 +134,12 @@ std::vector<DynamicEntity*> narrowphaseDynamic(const CollisionResolver* collisio
 }
 
 std::vector<StaticEntity*> narrowphaseStatic(const CollisionResolver* collisionResolver, const DynamicEntity* entity) {
+	return narrowphaseStatic(collisionResolver, entity->getPosition(), entity->getRadius());
+}
+
+std::vector<StaticEntity*> narrowphaseStatic(const CollisionResolver* collisionResolver, const Vector2& position, float radius) {
 	std::vector<StaticEntity*> result;
-	Vector2 position = entity->getPosition();
-	float radius = entity->getRadius() + Config.MovementSafetyMargin;
+	radius += Config.MovementSafetyMargin;
 	
 	auto broadphaseResult = collisionResolver->broadphaseStatic(position, radius);
 
@@ -154,17 +157,16 @@ bool isPositionValid(const CollisionResolver* collisionResolver, const DynamicEn
 		&& narrowphaseStatic(collisionResolver, entity).size() == 0;
 }
 
+bool isPositionValid(const CollisionResolver* collisionResolver, const Vector2& position, float radius) {
+	return narrowphaseStatic(collisionResolver, position, radius).size() == 0;
+}
+
 bool checkMovementCollisions(const CollisionResolver* collisionResolver, const Movable* movable, const Segment& segment) {
 
 	float margin = movable->getRadius() + Config.MovementSafetyMargin + common::EPSILON;
 
-	float r2 = margin * margin;
-	
-	auto broadphaseStaticResult = collisionResolver->broadphaseStatic(segment.from, segment.to, margin);
-	for (StaticEntity* entity : broadphaseStaticResult) {
-		if (getSqDistanceTo(entity, segment) <= r2) {
-			return true;
-		}
+	if (checkStaticMovementCollisions(collisionResolver, segment, margin)) {
+		return true;
 	}
 
 	auto broadphaseDynamicResult = collisionResolver->broadphaseDynamic(segment.from, segment.to, margin);
@@ -177,3 +179,16 @@ bool checkMovementCollisions(const CollisionResolver* collisionResolver, const M
 	return false;
 }
 
+bool checkStaticMovementCollisions(const CollisionResolver* collisionResolver, const Segment& segment, float margin) {
+
+	float r2 = margin * margin;
+
+	auto broadphaseStaticResult = collisionResolver->broadphaseStatic(segment.from, segment.to, margin);
+	for (StaticEntity* entity : broadphaseStaticResult) {
+		if (getSqDistanceTo(entity, segment) <= r2) {
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -45,5 +45,9 @@ std::vector<Destructible*> getDestructibleInArea(const CollisionResolver* collis
 
 std::vector<DynamicEntity*> narrowphaseDynamic(const CollisionResolver* collisionResolver, const DynamicEntity* entity);
 std::vector<StaticEntity*> narrowphaseStatic(const CollisionResolver* collisionResolver, const DynamicEntity* entity);
+std::vector<StaticEntity*> narrowphaseStatic(const CollisionResolver* collisionResolver, const Vector2& position, float radius);
 bool isPositionValid(const CollisionResolver* collisionResolver, const DynamicEntity* entity, bool staticOnly = false);
-bool checkMovementCollisions(const CollisionResolver* collisionResolver, const Movable* entity, const Segment& segment);
\ No newline at end of file
+// Sprawdza pooenie koa o podanym promieniu wzgldem obiektw statycznych, bez odwoywania si do obiektw dynamicznych.
+bool isPositionValid(const CollisionResolver* collisionResolver, const Vector2& position, float radius);
+bool checkMovementCollisions(const CollisionResolver* collisionResolver, const Movable* entity, const Segment& segment);
+bool checkStaticMovementCollisions(const CollisionResolver* collisionResolver, const Segment& segment, float margin);
\ No newline at end of file
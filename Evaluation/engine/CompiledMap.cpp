@@ -0,0 +1,223 @@
+#include "engine/Navigation.h"
+#include "engine/CompiledMap.h"
+#include "engine/MappedFile.h"
+#include "entities/Wall.h"
+#include <cstring>
+
+// Odczyt kolejnych sekcji odwzorowanego pliku z kontrol jego rozmiaru.
+struct CompiledMapReader {
+	const char* position;
+	const char* end;
+
+	template <typename T> const T* read(size_t count) {
+		size_t size = count * sizeof(T);
+		if ((size_t)(end - position) < size) { return nullptr; }
+		const T* result = reinterpret_cast<const T*>(position);
+		position += (size + 3) / 4 * 4;
+		return result;
+	}
+};
+
+// Zapis sekcji do bufora z uzupenieniem do wielokrotnoci 4 bajtw.
+void appendSection(std::vector<char>& payload, const void* data, size_t size) {
+	const char* bytes = static_cast<const char*>(data);
+	payload.insert(payload.end(), bytes, bytes + size);
+	payload.resize(payload.size() + (4 - size % 4) % 4, 0);
+}
+
+template <typename T> void appendSection(std::vector<char>& payload, const std::vector<T>& data) {
+	if (!data.empty()) {
+		appendSection(payload, data.data(), data.size() * sizeof(T));
+	}
+}
+
+// Suma kontrolna zawartoci pliku. Zwraca false, jeeli pliku nie mona odczyta.
+bool computeFileChecksum(const String& filename, uint64_t& checksum) {
+	MappedFile file;
+	if (!file.open(filename)) { return false; }
+	checksum = computeChecksum(file.getData(), file.getSize());
+	return true;
+}
+
+void GameMap::compile(const String& inputFile, const String& outputFile) {
+	Loader().compile(inputFile, outputFile);
+}
+
+void GameMap::Loader::compile(const String& inputFile, const String& outputFile) {
+	_map = new GameMap();
+	_map->_pathCache = nullptr;
+	_map->_hierarchy = nullptr;
+	_map->_collisionResolver = nullptr;
+
+	std::vector<TriggerSpawn> triggers;
+	try {
+		loadText(inputFile, triggers);
+		saveCompiled(outputFile, inputFile, triggers);
+	}
+	catch (...) {
+		GameMap::destroy(_map);
+		throw;
+	}
+	GameMap::destroy(_map);
+}
+
+void GameMap::Loader::saveCompiled(const String& filename, const String& sourceFilename, const std::vector<TriggerSpawn>& triggers) const {
+	std::vector<CompiledNode> nodes;
+	std::vector<CompiledArc> arcs;
+	for (const NavigationNode& node : _map->_navigationMesh) {
+		nodes.push_back({ node.position.x, node.position.y, node.index, (uint32_t)node.arcs.size() });
+		for (const NavigationNode::Arc& arc : node.arcs) {
+			arcs.push_back({ arc.first, arc.second });
+		}
+	}
+
+	std::vector<CompiledWall> walls;
+	for (StaticEntity* entity : _map->_walls) {
+		const Wall* wall = static_cast<const Wall*>(entity);
+		walls.push_back({ wall->getFrom().x, wall->getFrom().y, wall->getTo().x, wall->getTo().y, wall->getId(), wall->getPriority() });
+	}
+
+	std::vector<CompiledCell> cells;
+	std::vector<int32_t> cellIndices;
+	for (const NavigationCell& cell : _map->_navigationCells) {
+		cells.push_back({ (uint32_t)cell.nodes.size(), (uint32_t)cell.visibleNodes.size() });
+		cellIndices.insert(cellIndices.end(), cell.nodes.begin(), cell.nodes.end());
+		cellIndices.insert(cellIndices.end(), cell.visibleNodes.begin(), cell.visibleNodes.end());
+	}
+
+	std::vector<CompiledTrigger> compiledTriggers;
+	std::vector<char> names;
+	for (const TriggerSpawn& trigger : triggers) {
+		compiledTriggers.push_back({ trigger.position.x, trigger.position.y, (uint32_t)trigger.type.size() });
+		names.insert(names.end(), trigger.type.begin(), trigger.type.end());
+	}
+
+	std::vector<char> payload;
+	appendSection(payload, nodes);
+	appendSection(payload, arcs);
+	appendSection(payload, walls);
+	appendSection(payload, cells);
+	appendSection(payload, cellIndices);
+	appendSection(payload, compiledTriggers);
+	appendSection(payload, names);
+
+	CompiledMapHeader header;
+	std::memset(&header, 0, sizeof(header));
+	header.header = COMPILED_MAP_HEADER;
+	header.version = COMPILED_MAP_VERSION;
+	header.checksum = computeChecksum(payload.data(), payload.size());
+	header.payloadSize = payload.size();
+	if (!computeFileChecksum(sourceFilename, header.sourceChecksum)) {
+		throw "Nie mona odczyta pliku '" + sourceFilename + "'.";
+	}
+	header.width = _map->_width;
+	header.height = _map->_height;
+	header.nodesCount = nodes.size();
+	header.arcsCount = arcs.size();
+	header.wallsCount = walls.size();
+	header.cellSize = _map->_navigationCellSize;
+	header.cellsX = _map->_navigationCellsX;
+	header.cellsY = _map->_navigationCellsY;
+	header.cellIndicesCount = cellIndices.size();
+	header.triggersCount = compiledTriggers.size();
+	header.namesSize = names.size();
+
+	std::ofstream writer(filename, std::ios::binary | std::ios::trunc);
+	if (writer.fail()) {
+		throw "Nie mona zapisa pliku '" + filename + "'.";
+	}
+	writer.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	writer.write(payload.data(), payload.size());
+}
+
+bool GameMap::Loader::loadCompiled(const String& filename, const String& sourceFilename, std::vector<TriggerSpawn>& triggers) {
+	MappedFile file;
+	if (!file.open(filename) || file.getSize() < sizeof(CompiledMapHeader)) { return false; }
+
+	const CompiledMapHeader* header = reinterpret_cast<const CompiledMapHeader*>(file.getData());
+	const char* payload = file.getData() + sizeof(CompiledMapHeader);
+	size_t payloadSize = file.getSize() - sizeof(CompiledMapHeader);
+
+	// Nieaktualna wersja formatu, uszkodzony plik, siatka nawigacji o innym rozmiarze komrek
+	// lub plik tekstowy zmieniony po kompilacji powoduj wczytanie mapy z pliku tekstowego.
+	// Skompilowana mapa bez pliku tekstowego jest uywana bez sprawdzania jego sumy kontrolnej.
+	uint64_t sourceChecksum;
+	if (header->header != COMPILED_MAP_HEADER || header->version != COMPILED_MAP_VERSION
+		|| header->payloadSize != payloadSize || header->checksum != computeChecksum(payload, payloadSize)
+		|| header->cellSize != Config.RegularGridSize
+		|| (computeFileChecksum(sourceFilename, sourceChecksum) && sourceChecksum != header->sourceChecksum)) {
+		return false;
+	}
+
+	CompiledMapReader reader = { payload, payload + payloadSize };
+	const CompiledNode* nodes = reader.read<CompiledNode>(header->nodesCount);
+	const CompiledArc* arcs = reader.read<CompiledArc>(header->arcsCount);
+	const CompiledWall* walls = reader.read<CompiledWall>(header->wallsCount);
+	const CompiledCell* cells = reader.read<CompiledCell>(header->cellsX * header->cellsY);
+	const int32_t* cellIndices = reader.read<int32_t>(header->cellIndicesCount);
+	const CompiledTrigger* compiledTriggers = reader.read<CompiledTrigger>(header->triggersCount);
+	const char* names = reader.read<char>(header->namesSize);
+	if (nodes == nullptr || arcs == nullptr || walls == nullptr || cells == nullptr
+		|| cellIndices == nullptr || compiledTriggers == nullptr || names == nullptr) {
+		return false;
+	}
+
+	// Poprawno indeksw jest sprawdzana przed utworzeniem jakichkolwiek obiektw.
+	uint32_t n = header->nodesCount;
+	uint64_t arcsCount = 0, indicesCount = 0, namesSize = 0;
+	for (uint32_t i = 0; i < n; ++i) { arcsCount += nodes[i].arcsCount; }
+	for (uint32_t i = 0; i < header->arcsCount; ++i) {
+		if (arcs[i].to < 0 || (uint32_t)arcs[i].to >= n) { return false; }
+	}
+	for (uint32_t i = 0; i < header->cellsX * header->cellsY; ++i) {
+		indicesCount += cells[i].nodesCount + cells[i].visibleNodesCount;
+	}
+	for (uint32_t i = 0; i < header->cellIndicesCount; ++i) {
+		if (cellIndices[i] < 0 || (uint32_t)cellIndices[i] >= n) { return false; }
+	}
+	for (uint32_t i = 0; i < header->triggersCount; ++i) { namesSize += compiledTriggers[i].nameLength; }
+	if (arcsCount != header->arcsCount || indicesCount != header->cellIndicesCount
+		|| namesSize != header->namesSize || header->cellsX == 0 || header->cellsY == 0) {
+		return false;
+	}
+
+	_map->_width = header->width;
+	_map->_height = header->height;
+
+	_map->_navigationMesh.reserve(n);
+	for (uint32_t i = 0; i < n; ++i) {
+		_map->_navigationMesh.push_back(NavigationNode(nodes[i].x, nodes[i].y, nodes[i].index));
+		NavigationNode& node = _map->_navigationMesh.back();
+		node.arcs.reserve(nodes[i].arcsCount);
+		for (uint32_t j = 0; j < nodes[i].arcsCount; ++j, ++arcs) {
+			node.arcs.push_back(NavigationNode::Arc(arcs->to, arcs->cost));
+		}
+	}
+
+	_map->_walls.reserve(header->wallsCount);
+	for (uint32_t i = 0; i < header->wallsCount; ++i) {
+		const CompiledWall& wall = walls[i];
+		_map->_walls.push_back(new Wall(wall.id, Vector2(wall.fromX, wall.fromY), Vector2(wall.toX, wall.toY), wall.priority));
+	}
+
+	_map->_navigationCellSize = header->cellSize;
+	_map->_navigationCellsX = header->cellsX;
+	_map->_navigationCellsY = header->cellsY;
+	_map->_navigationCells = std::vector<NavigationCell>(header->cellsX * header->cellsY);
+	for (NavigationCell& cell : _map->_navigationCells) {
+		cell.nodes.assign(cellIndices, cellIndices + cells->nodesCount);
+		cellIndices += cells->nodesCount;
+		cell.visibleNodes.assign(cellIndices, cellIndices + cells->visibleNodesCount);
+		cellIndices += cells->visibleNodesCount;
+		++cells;
+	}
+
+	triggers.reserve(header->triggersCount);
+	for (uint32_t i = 0; i < header->triggersCount; ++i) {
+		const CompiledTrigger& trigger = compiledTriggers[i];
+		triggers.push_back({ String(names, trigger.nameLength), Vector2(trigger.x, trigger.y) });
+		names += trigger.nameLength;
+	}
+
+	return true;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Binarny format mapy. Plik skada si z nagwka i nastpujcych po nim sekcji (tablic struktur,
+// wyrwnanych do 4 bajtw): wzy nawigacji, uki, ciany, komrki siatki nawigacji, indeksy wzw
+// komrek, wyzwalacze i ich nazwy. Suma kontrolna obejmuje wszystkie sekcje. Nagwek zawiera take
+// sum kontroln pliku tekstowego, z ktrego skompilowano map, co pozwala wykry jego pniejsze zmiany.
+
+const uint32_t COMPILED_MAP_HEADER = 0x50414d45;
+const uint32_t COMPILED_MAP_VERSION = 2;
+
+struct CompiledMapHeader {
+	uint32_t header;
+	uint32_t version;
+	uint64_t checksum;
+	uint64_t payloadSize;
+	uint64_t sourceChecksum;
+	float width;
+	float height;
+	uint32_t nodesCount;
+	uint32_t arcsCount;
+	uint32_t wallsCount;
+	float cellSize;
+	uint32_t cellsX;
+	uint32_t cellsY;
+	uint32_t cellIndicesCount;
+	uint32_t triggersCount;
+	uint32_t namesSize;
+	uint32_t padding;
+};
+
+struct CompiledNode {
+	float x;
+	float y;
+	int32_t index;
+	// uki wzw s zapisane kolejno, w porzdku wzw.
+	uint32_t arcsCount;
+};
+
+struct CompiledArc {
+	int32_t to;
+	float cost;
+};
+
+struct CompiledWall {
+	float fromX;
+	float fromY;
+	float toX;
+	float toY;
+	int32_t id;
+	int32_t priority;
+};
+
+// Indeksy wzw komrek zapisane s kolejno: wzy komrki, a po nich wzy z niej widoczne.
+struct CompiledCell {
+	uint32_t nodesCount;
+	uint32_t visibleNodesCount;
+};
+
+struct CompiledTrigger {
+	float x;
+	float y;
+	uint32_t nameLength;
+};
+
+// Suma kontrolna FNV-1a. Podanie poprzedniego wyniku jako hash pozwala liczy j fragmentami.
+inline uint64_t computeChecksum(const void* data, size_t size, uint64_t hash = 14695981039346656037ULL) {
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	for (size_t i = 0; i < size; ++i) {
+		hash = (hash ^ bytes[i]) * 1099511628211ULL;
+	}
+	return hash;
+}
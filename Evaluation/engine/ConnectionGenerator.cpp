@@ -0,0 +1,157 @@
+#include "engine/ConnectionGenerator.h"
+#include "engine/CommonFunctions.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+const int ConnectionGenerator::NULL_IDX = -1;
+const int ConnectionGenerator::MAX_WALLS_IN_LEAF = 4;
+
+ConnectionGenerator::ConnectionGenerator(const std::vector<Vector2>& points, const std::vector<Segment>& walls,
+	float width, float height, float clearance) : _points(points), _walls(walls), _clearance(clearance) {
+
+	if (!_walls.empty()) {
+		_wallNodes.reserve(2 * _walls.size());
+		buildWallTree(0, _walls.size());
+	}
+
+	// rednio kilka punktw w komrce siatki.
+	int n = common::max(1, (int)points.size());
+	_cellSize = common::max(1, sqrtf(4 * width * height / n));
+	_cellsX = common::max(1, ceilf(width / _cellSize));
+	_cellsY = common::max(1, ceilf(height / _cellSize));
+	_cells.resize(_cellsX * _cellsY);
+
+	for (int i = 0; i < (int)points.size(); ++i) {
+		int cellX = common::max(0, common::min(_cellsX - 1, (int)floorf(points[i].x / _cellSize)));
+		int cellY = common::max(0, common::min(_cellsY - 1, (int)floorf(points[i].y / _cellSize)));
+		_cells[cellY * _cellsX + cellX].push_back(i);
+	}
+}
+
+// Budowa drzewa metod top-down: ciany s dzielone wzgldem mediany rodkw wzdu duszego boku.
+int ConnectionGenerator::buildWallTree(int first, int count) {
+	Aabb aabb(_walls[first].from, _walls[first].to);
+	for (int i = first + 1; i < first + count; ++i) {
+		aabb = Aabb::merge(aabb, Aabb(_walls[i].from, _walls[i].to));
+	}
+
+	int index = _wallNodes.size();
+	_wallNodes.push_back({ aabb, first, count, NULL_IDX, NULL_IDX });
+	if (count <= MAX_WALLS_IN_LEAF) { return index; }
+
+	bool splitX = aabb.getWidth() >= aabb.getHeight();
+	auto begin = _walls.begin() + first;
+	std::nth_element(begin, begin + count / 2, begin + count, [splitX](const Segment& s1, const Segment& s2) {
+		return splitX ? s1.from.x + s1.to.x < s2.from.x + s2.to.x : s1.from.y + s1.to.y < s2.from.y + s2.to.y;
+	});
+
+	int left = buildWallTree(first, count / 2);
+	int right = buildWallTree(first + count / 2, count - count / 2);
+	_wallNodes[index].left = left;
+	_wallNodes[index].right = right;
+	return index;
+}
+
+bool ConnectionGenerator::isNearWall(const Segment& arc) const {
+	if (_wallNodes.empty()) { return false; }
+
+	Aabb query = Aabb(arc.from, arc.to).inflate(_clearance);
+	float sqClearance = _clearance * _clearance;
+
+	int stack[64];
+	int size = 0;
+	stack[size++] = 0;
+	while (size > 0) {
+		const WallNode& node = _wallNodes[stack[--size]];
+		if (!node.aabb.intersects(query)) { continue; }
+		if (node.left == NULL_IDX) {
+			for (int i = node.first; i < node.first + node.count; ++i) {
+				if (common::sqDist(arc, _walls[i]) < sqClearance) { return true; }
+			}
+		}
+		else {
+			stack[size++] = node.left;
+			stack[size++] = node.right;
+		}
+	}
+	return false;
+}
+
+// Przeglda kolejne kolumny siatki przecinane przez odcinek i tylko te ich komrki,
+// przez ktre odcinek przechodzi.
+bool ConnectionGenerator::containsOtherPoint(const Segment& arc) const {
+	float epsilon = common::EPSILON;
+	Vector2 from = arc.from.x <= arc.to.x ? arc.from : arc.to;
+	Vector2 to = arc.from.x <= arc.to.x ? arc.to : arc.from;
+
+	int firstColumn = common::max(0, (int)floorf((from.x - epsilon) / _cellSize));
+	int lastColumn = common::min(_cellsX - 1, (int)floorf((to.x + epsilon) / _cellSize));
+	float dx = to.x - from.x;
+
+	for (int column = firstColumn; column <= lastColumn; ++column) {
+		float left = common::max(from.x, column * _cellSize);
+		float right = common::min(to.x, (column + 1) * _cellSize);
+		float y1 = from.y, y2 = to.y;
+		if (dx > epsilon) {
+			y1 = from.y + (to.y - from.y) * (left - from.x) / dx;
+			y2 = from.y + (to.y - from.y) * (right - from.x) / dx;
+		}
+		int firstRow = common::max(0, (int)floorf((common::min(y1, y2) - epsilon) / _cellSize));
+		int lastRow = common::min(_cellsY - 1, (int)floorf((common::max(y1, y2) + epsilon) / _cellSize));
+
+		for (int row = firstRow; row <= lastRow; ++row) {
+			for (int index : _cells[row * _cellsX + column]) {
+				const Vector2& point = _points[index];
+				if (common::sqDist(point, arc.from) > epsilon
+					&& common::sqDist(point, arc.to) > epsilon
+					&& common::distance(point, arc) < epsilon) {
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+bool ConnectionGenerator::isConnectionValid(int i, int j) const {
+	Segment arc(_points[i], _points[j]);
+	return !isNearWall(arc) && !containsOtherPoint(arc);
+}
+
+std::vector<std::pair<int, int>> ConnectionGenerator::generate(size_t threadsCount,
+	const std::function<bool(int, int)>& accept) const {
+
+	int n = _points.size();
+	std::vector<std::vector<int>> rows(n);
+	std::atomic<int> nextRow(0);
+
+	// Wiersze s przydzielane dynamicznie, poniewa kolejne zawieraj coraz mniej par.
+	auto worker = [&]() {
+		int i;
+		while ((i = nextRow++) < n) {
+			for (int j = i + 1; j < n; ++j) {
+				if (accept(i, j) && isConnectionValid(i, j)) {
+					rows[i].push_back(j);
+				}
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t t = 1; t < threadsCount; ++t) {
+		threads.push_back(std::thread(worker));
+	}
+	worker();
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	std::vector<std::pair<int, int>> result;
+	for (int i = 0; i < n; ++i) {
+		for (int j : rows[i]) {
+			result.push_back(std::make_pair(i, j));
+		}
+	}
+	return result;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include "math/Aabb.h"
+#include "math/Math.h"
+
+// Wyznacza poczenia siatki nawigacji. Para punktw jest czona, jeeli odcinek midzy nimi
+// przebiega w odlegoci co najmniej clearance od cian i nie przechodzi przez inny punkt.
+// ciany s przechowywane w statycznym drzewie Aabb, a punkty w regularnej siatce.
+class ConnectionGenerator {
+public:
+	ConnectionGenerator(const std::vector<Vector2>& points, const std::vector<Segment>& walls,
+		float width, float height, float clearance);
+
+	// Rozwaa pary (i, j), i < j, dla ktrych accept(i, j) zwraca true. Wynik jest uporzdkowany
+	// leksykograficznie, niezalenie od liczby wtkw.
+	std::vector<std::pair<int, int>> generate(size_t threadsCount, const std::function<bool(int, int)>& accept) const;
+
+private:
+	struct WallNode {
+		Aabb aabb;
+		// Dla licia: zakres cian [first, first + count), w przeciwnym razie indeksy dzieci.
+		int first;
+		int count;
+		int left;
+		int right;
+	};
+
+	static const int NULL_IDX;
+	static const int MAX_WALLS_IN_LEAF;
+
+	std::vector<Vector2> _points;
+	std::vector<Segment> _walls;
+	std::vector<WallNode> _wallNodes;
+	float _clearance;
+
+	std::vector<std::vector<int>> _cells;
+	float _cellSize;
+	int _cellsX;
+	int _cellsY;
+
+	int buildWallTree(int first, int count);
+	bool isNearWall(const Segment& arc) const;
+	bool containsOtherPoint(const Segment& arc) const;
+	bool isConnectionValid(int i, int j) const;
+};
@@ -0,0 +1,81 @@
+#include "FlowField.h"
+#include "engine/Navigation.h"
+#include "main/Game.h"
+
+const int FlowField::NULL_IDX = -1;
+
+FlowField::FlowField(int target, std::vector<int>&& nextNodes, std::vector<float>&& distances)
+	: _target(target), _nextNodes(std::move(nextNodes)), _distances(std::move(distances)) {}
+
+int FlowField::getTarget() const { return _target; }
+
+bool FlowField::isReachable(int node) const { return node == _target || _nextNodes[node] != NULL_IDX; }
+
+float FlowField::getDistance(int node) const { return _distances[node]; }
+
+bool FlowField::getPath(int from, std::vector<int>& path) const {
+	path.clear();
+	if (!isReachable(from)) { return false; }
+	for (int node = from; node != _target; node = _nextNodes[node]) {
+		path.push_back(node);
+	}
+	path.push_back(_target);
+	std::reverse(path.begin(), path.end());
+	return true;
+}
+
+FlowFieldService::FlowFieldService(const GameMap* map) : _map(map), _computedCount(0) {}
+
+std::shared_ptr<const FlowField> FlowFieldService::acquire(const Vector2& target) {
+	int node = _map->getClosestNavigationNode(target);
+	if (node == FlowField::NULL_IDX) { return nullptr; }
+
+	std::promise<std::shared_ptr<const FlowField>> promise;
+	std::shared_future<std::shared_ptr<const FlowField>> field;
+	bool isComputing = false;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto it = _fields.find(node);
+		if (it == _fields.end()) {
+			field = promise.get_future().share();
+			_fields[node] = { field, Game::getCurrentTime() };
+			++_computedCount;
+			isComputing = true;
+		}
+		else {
+			it->second.lastAccess = Game::getCurrentTime();
+			field = it->second.field;
+		}
+	}
+
+	// Pole jest wyznaczane poza sekcj krytyczn, wic nie wstrzymuje zapyta o inne cele.
+	if (isComputing) {
+		promise.set_value(_map->computeFlowField(node));
+	}
+	return field.get();
+}
+
+void FlowFieldService::collect(GameTime time) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	for (auto it = _fields.begin(); it != _fields.end(); ) {
+		const Entry& entry = it->second;
+		if (time > entry.lastAccess && time - entry.lastAccess > Config.FlowFieldExpiryTime
+			&& entry.field.wait_for(std::chrono::seconds(0)) == std::future_status::ready
+			&& entry.field.get().use_count() == 1) {
+			it = _fields.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+}
+
+size_t FlowFieldService::getFieldsCount() const {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _fields.size();
+}
+
+size_t FlowFieldService::getComputedCount() const {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _computedCount;
+}
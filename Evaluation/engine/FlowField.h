@@ -0,0 +1,58 @@
+#pragma once
+
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "main/Configuration.h"
+#include "math/Math.h"
+
+class GameMap;
+
+// Pole kierunkw prowadzce do jednego wza nawigacji. Dla kadego wza zapamitany jest kolejny
+// wze najkrtszej cieki do celu, wic ciek z dowolnego miejsca odczytuje si bez wyszukiwania.
+class FlowField {
+public:
+	FlowField(int target, std::vector<int>&& nextNodes, std::vector<float>&& distances);
+
+	int getTarget() const;
+	bool isReachable(int node) const;
+	float getDistance(int node) const;
+	// Podobnie jak w GameMap::aStar, cieka zapisywana jest od wza docelowego do pocztkowego.
+	bool getPath(int from, std::vector<int>& path) const;
+
+	static const int NULL_IDX;
+
+private:
+	int _target;
+	std::vector<int> _nextNodes;
+	std::vector<float> _distances;
+};
+
+// Usuga udostpniajca pola kierunkw wspdzielone przez obiekty zmierzajce do tego samego celu.
+// Cel jest utosamiany z najbliszym wzem nawigacji. Pole jest wyznaczane przy pierwszym zapytaniu,
+// a zapytania o ten sam cel zgoszone w trakcie oblicze czekaj na jego wynik.
+// Pole jest usuwane przez collect, gdy aden obiekt go nie uywa (jedyn referencj posiada usuga)
+// i nikt o nie nie pyta przez Config.FlowFieldExpiryTime.
+class FlowFieldService {
+public:
+	FlowFieldService(const GameMap* map);
+
+	std::shared_ptr<const FlowField> acquire(const Vector2& target);
+	void collect(GameTime time);
+
+	size_t getFieldsCount() const;
+	size_t getComputedCount() const;
+
+private:
+	struct Entry {
+		std::shared_future<std::shared_ptr<const FlowField>> field;
+		GameTime lastAccess;
+	};
+
+	const GameMap* _map;
+	std::map<int, Entry> _fields;
+	size_t _computedCount;
+	mutable std::mutex _mutex;
+};
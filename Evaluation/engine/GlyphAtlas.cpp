@@ -0,0 +1,78 @@
+#include "GlyphAtlas.h"
+
+GlyphAtlas::GlyphAtlas(SDL_Renderer* renderer, TTF_Font* font) : _texture(nullptr), _height(TTF_FontHeight(font)) {
+	const SDL_Color white = { 255, 255, 255, 255 };
+	SDL_Surface* surfaces[GLYPHS_COUNT];
+
+	// Znaki ukadane s w wierszach o szerokoci nie wikszej ni MAX_ROW_WIDTH.
+	int x = 0, y = 0, width = 0;
+	for (int i = 0; i < GLYPHS_COUNT; ++i) {
+		char text[2] = { char(FIRST_GLYPH + i), '\0' };
+		surfaces[i] = TTF_RenderText_Blended(font, text, white);
+		int glyphWidth = 0;
+		if (surfaces[i] != nullptr) { glyphWidth = surfaces[i]->w; }
+		else { TTF_SizeText(font, text, &glyphWidth, nullptr); }
+
+		if (x + glyphWidth > MAX_ROW_WIDTH) {
+			x = 0;
+			y += _height;
+		}
+		_glyphs[i] = { x, y, glyphWidth, _height };
+		x += glyphWidth;
+		if (x > width) { width = x; }
+	}
+
+	SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, width, y + _height, 32, SDL_PIXELFORMAT_ARGB8888);
+	if (atlas != nullptr) {
+		for (int i = 0; i < GLYPHS_COUNT; ++i) {
+			if (surfaces[i] != nullptr) {
+				// Kana alfa znaku jest kopiowany, a nie mieszany z przezroczystym tem.
+				SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+				SDL_Rect target = _glyphs[i];
+				SDL_BlitSurface(surfaces[i], nullptr, atlas, &target);
+			}
+		}
+		_texture = SDL_CreateTextureFromSurface(renderer, atlas);
+		if (_texture != nullptr) {
+			SDL_SetTextureBlendMode(_texture, SDL_BLENDMODE_BLEND);
+		}
+		SDL_FreeSurface(atlas);
+	}
+
+	for (int i = 0; i < GLYPHS_COUNT; ++i) {
+		if (surfaces[i] != nullptr) { SDL_FreeSurface(surfaces[i]); }
+	}
+}
+
+GlyphAtlas::~GlyphAtlas() {
+	if (_texture != nullptr) { SDL_DestroyTexture(_texture); }
+}
+
+const SDL_Rect& GlyphAtlas::getGlyph(char c) const {
+	if (c < FIRST_GLYPH || c > LAST_GLYPH) { c = '?'; }
+	return _glyphs[c - FIRST_GLYPH];
+}
+
+int GlyphAtlas::getTextWidth(const char* text) const {
+	int width = 0;
+	for (const char* c = text; *c != '\0'; ++c) {
+		width += getGlyph(*c).w;
+	}
+	return width;
+}
+
+int GlyphAtlas::getHeight() const { return _height; }
+
+void GlyphAtlas::draw(SDL_Renderer* renderer, const char* text, int x, int y, const SDL_Color& color) const {
+	if (_texture == nullptr) { return; }
+	SDL_SetTextureColorMod(_texture, color.r, color.g, color.b);
+	SDL_SetTextureAlphaMod(_texture, color.a);
+	for (const char* c = text; *c != '\0'; ++c) {
+		const SDL_Rect& glyph = getGlyph(*c);
+		if (*c != ' ') {
+			SDL_Rect target = { x, y, glyph.w, glyph.h };
+			SDL_RenderCopy(renderer, _texture, &glyph, &target);
+		}
+		x += glyph.w;
+	}
+}
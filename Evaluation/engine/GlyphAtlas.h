@@ -0,0 +1,34 @@
+#pragma once
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+
+// Tekstura zawierajca wszystkie drukowalne znaki ASCII jednej czcionki. Napis jest rysowany
+// jako cig prostoktw kopiowanych z tej samej tekstury, bez rasteryzacji i tworzenia nowych tekstur.
+// Znaki spoza zakresu zastpowane s znakiem '?'.
+class GlyphAtlas {
+public:
+	GlyphAtlas(SDL_Renderer* renderer, TTF_Font* font);
+	~GlyphAtlas();
+
+	GlyphAtlas(const GlyphAtlas&) = delete;
+	GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+	int getTextWidth(const char* text) const;
+	int getHeight() const;
+
+	// Rysuje napis, ktrego lewy grny rg znajduje si w punkcie (x, y) ekranu.
+	void draw(SDL_Renderer* renderer, const char* text, int x, int y, const SDL_Color& color) const;
+
+private:
+	static const char FIRST_GLYPH = ' ';
+	static const char LAST_GLYPH = '~';
+	static const int GLYPHS_COUNT = LAST_GLYPH - FIRST_GLYPH + 1;
+	static const int MAX_ROW_WIDTH = 512;
+
+	SDL_Texture* _texture;
+	SDL_Rect _glyphs[GLYPHS_COUNT];
+	int _height;
+
+	const SDL_Rect& getGlyph(char c) const;
+};
@@ -0,0 +1,265 @@
+#include "engine/HierarchicalGraph.h"
+#include "engine/Navigation.h"
+#include "engine/IndexedHeap.h"
+#include "engine/CommonFunctions.h"
+#include <algorithm>
+
+const int HierarchicalGraph::NULL_IDX = -1;
+
+// Wyniki przeszukiwania (klastra lub grafu abstrakcyjnego) ze znacznikami generacji,
+// dziki ktrym kolejne zapytania nie musz czyci caych tablic.
+struct HierarchicalSearchWorkspace {
+	std::vector<unsigned int> generations;
+	std::vector<float> costs;
+	std::vector<int> previous;
+	std::vector<int> edges;
+	IndexedHeap<float> open;
+	unsigned int generation = 0;
+
+	void prepare(size_t nodesCount) {
+		if (generations.size() < nodesCount) {
+			generations.resize(nodesCount, 0);
+			costs.resize(nodesCount);
+			previous.resize(nodesCount);
+			edges.resize(nodesCount);
+			open.reserve(nodesCount);
+		}
+		open.clear();
+		if (++generation == 0) {
+			std::fill(generations.begin(), generations.end(), 0);
+			generation = 1;
+		}
+	}
+
+	bool isReached(int index) const { return generations[index] == generation; }
+
+	// Zwraca true, jeeli koszt dotarcia do wza uleg zmniejszeniu.
+	bool reach(int index, float cost, int from, int edge) {
+		if (isReached(index) && costs[index] <= cost) { return false; }
+		generations[index] = generation;
+		costs[index] = cost;
+		previous[index] = from;
+		edges[index] = edge;
+		return true;
+	}
+};
+
+// Przestrzenie robocze wtku: przeszukiwanie klastra pocztkowego, klastra docelowego i grafu abstrakcyjnego.
+thread_local HierarchicalSearchWorkspace hierarchicalForwardSearch;
+thread_local HierarchicalSearchWorkspace hierarchicalBackwardSearch;
+thread_local HierarchicalSearchWorkspace hierarchicalAbstractSearch;
+
+HierarchicalGraph::HierarchicalGraph(const std::vector<Vector2>& positions, const std::vector<std::vector<Arc>>& arcs,
+	float width, float height, float clusterSize) : _positions(positions), _arcs(arcs), _clusterSize(clusterSize) {
+
+	int n = positions.size();
+	_clustersX = common::max(1, ceilf(width / clusterSize));
+	_clustersY = common::max(1, ceilf(height / clusterSize));
+	_clusterEntrances.resize(_clustersX * _clustersY);
+	_clusters.resize(n);
+	_reverseArcs.resize(n);
+	_entranceIds.assign(n, NULL_IDX);
+
+	for (int i = 0; i < n; ++i) {
+		_clusters[i] = getCluster(positions[i]);
+	}
+
+	for (int i = 0; i < n; ++i) {
+		for (const Arc& arc : arcs[i]) {
+			_reverseArcs[arc.first].push_back(Arc(i, arc.second));
+			if (_clusters[i] != _clusters[arc.first]) {
+				addEntrance(i);
+				addEntrance(arc.first);
+			}
+		}
+	}
+
+	_abstractEdges.resize(_entrances.size());
+	for (int i = 0; i < n; ++i) {
+		for (const Arc& arc : arcs[i]) {
+			if (_clusters[i] != _clusters[arc.first]) {
+				_abstractEdges[_entranceIds[i]].push_back({ _entranceIds[arc.first], arc.second, NULL_IDX });
+			}
+		}
+	}
+
+	// Najkrtsze cieki wewntrz klastrw midzy kad par jego wej.
+	HierarchicalSearchWorkspace workspace;
+	for (int entrance = 0; entrance < (int)_entrances.size(); ++entrance) {
+		int source = _entrances[entrance];
+		searchCluster(source, false, {}, workspace);
+
+		for (int target : _clusterEntrances[_clusters[source]]) {
+			int targetNode = _entrances[target];
+			if (target == entrance || !workspace.isReached(targetNode)) { continue; }
+
+			std::vector<int> path;
+			for (int node = targetNode; node != NULL_IDX; node = workspace.previous[node]) {
+				path.push_back(node);
+			}
+			std::reverse(path.begin(), path.end());
+
+			_abstractEdges[entrance].push_back({ target, workspace.costs[targetNode], (int)_edgePaths.size() });
+			_edgePaths.push_back(path);
+		}
+	}
+}
+
+size_t HierarchicalGraph::getClustersCount() const { return _clusterEntrances.size(); }
+
+size_t HierarchicalGraph::getEntrancesCount() const { return _entrances.size(); }
+
+int HierarchicalGraph::getCluster(const Vector2& position) const {
+	int i = (int)floorf(position.x / _clusterSize);
+	int j = (int)floorf(position.y / _clusterSize);
+	i = i < 0 ? 0 : i >= _clustersX ? _clustersX - 1 : i;
+	j = j < 0 ? 0 : j >= _clustersY ? _clustersY - 1 : j;
+	return j * _clustersX + i;
+}
+
+void HierarchicalGraph::addEntrance(int node) {
+	if (_entranceIds[node] == NULL_IDX) {
+		_entranceIds[node] = _entrances.size();
+		_clusterEntrances[_clusters[node]].push_back(_entrances.size());
+		_entrances.push_back(node);
+	}
+}
+
+void HierarchicalGraph::searchCluster(int source, bool reverse,
+	const std::vector<common::Circle>& ignoredAreas, HierarchicalSearchWorkspace& workspace) const {
+
+	const std::vector<std::vector<Arc>>& arcs = reverse ? _reverseArcs : _arcs;
+	int cluster = _clusters[source];
+
+	workspace.prepare(_positions.size());
+	workspace.reach(source, 0, NULL_IDX, NULL_IDX);
+	workspace.open.pushOrDecrease(source, 0);
+
+	while (!workspace.open.isEmpty()) {
+		float currentCost = workspace.open.topKey();
+		int current = workspace.open.pop();
+
+		if (!ignoredAreas.empty() && isInIgnoredArea(_positions[current], ignoredAreas)) { continue; }
+
+		for (const Arc& arc : arcs[current]) {
+			int next = arc.first;
+			if (_clusters[next] != cluster) { continue; }
+			if (!ignoredAreas.empty() && isArcInIgnoredArea(Segment(_positions[current], _positions[next]), ignoredAreas)) {
+				continue;
+			}
+			if (workspace.reach(next, currentCost + arc.second, current, NULL_IDX)) {
+				workspace.open.pushOrDecrease(next, currentCost + arc.second);
+			}
+		}
+	}
+}
+
+bool HierarchicalGraph::isEdgeInIgnoredArea(int from, const AbstractEdge& edge, const std::vector<common::Circle>& ignoredAreas) const {
+	if (edge.path == NULL_IDX) {
+		Vector2 target = _positions[_entrances[edge.to]];
+		return isInIgnoredArea(target, ignoredAreas)
+			|| isArcInIgnoredArea(Segment(_positions[_entrances[from]], target), ignoredAreas);
+	}
+
+	const std::vector<int>& path = _edgePaths[edge.path];
+	for (size_t i = 1; i < path.size(); ++i) {
+		if (isInIgnoredArea(_positions[path[i]], ignoredAreas)
+			|| isArcInIgnoredArea(Segment(_positions[path[i - 1]], _positions[path[i]]), ignoredAreas)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool HierarchicalGraph::findPath(int from, int to, const std::vector<common::Circle>& ignoredAreas, std::vector<int>& path) const {
+	path.clear();
+
+	// cieka wewntrz klastra pocztkowego jest wyznaczana od razu, dalsze odcinki to cieki
+	// zapamitane w krawdziach grafu abstrakcyjnego.
+	HierarchicalSearchWorkspace& forward = hierarchicalForwardSearch;
+	searchCluster(from, false, ignoredAreas, forward);
+
+	if (_clusters[from] == _clusters[to] && forward.isReached(to)) {
+		for (int node = to; node != NULL_IDX; node = forward.previous[node]) {
+			path.push_back(node);
+		}
+		return true;
+	}
+
+	HierarchicalSearchWorkspace& backward = hierarchicalBackwardSearch;
+	searchCluster(to, true, ignoredAreas, backward);
+
+	// Wze abstrakcyjny o indeksie rwnym liczbie wej reprezentuje cel.
+	int goal = _entrances.size();
+	int goalCluster = _clusters[to];
+	Vector2 goalPosition = _positions[to];
+	HierarchicalSearchWorkspace& search = hierarchicalAbstractSearch;
+	search.prepare(_entrances.size() + 1);
+
+	for (int entrance : _clusterEntrances[_clusters[from]]) {
+		int node = _entrances[entrance];
+		if (forward.isReached(node) && search.reach(entrance, forward.costs[node], NULL_IDX, NULL_IDX)) {
+			search.open.pushOrDecrease(entrance, forward.costs[node] + common::distance(_positions[node], goalPosition));
+		}
+	}
+
+	bool isPathFound = false;
+	while (!search.open.isEmpty()) {
+		int current = search.open.pop();
+		if (current == goal) {
+			isPathFound = true;
+			break;
+		}
+
+		int node = _entrances[current];
+		if (!ignoredAreas.empty() && isInIgnoredArea(_positions[node], ignoredAreas)) { continue; }
+		float currentCost = search.costs[current];
+
+		if (_clusters[node] == goalCluster && backward.isReached(node)
+			&& search.reach(goal, currentCost + backward.costs[node], current, NULL_IDX)) {
+			search.open.pushOrDecrease(goal, currentCost + backward.costs[node]);
+		}
+
+		const std::vector<AbstractEdge>& edges = _abstractEdges[current];
+		for (int i = 0; i < (int)edges.size(); ++i) {
+			const AbstractEdge& edge = edges[i];
+			float cost = currentCost + edge.cost;
+			if (search.isReached(edge.to) && search.costs[edge.to] <= cost) { continue; }
+			if (!ignoredAreas.empty() && isEdgeInIgnoredArea(current, edge, ignoredAreas)) { continue; }
+
+			search.reach(edge.to, cost, current, i);
+			search.open.pushOrDecrease(edge.to, cost + common::distance(_positions[_entrances[edge.to]], goalPosition));
+		}
+	}
+
+	if (!isPathFound) { return false; }
+
+	// Odcinek od ostatniego wejcia do celu (uki odwrcone prowadz w stron celu).
+	int last = search.previous[goal];
+	for (int node = _entrances[last]; node != to; ) {
+		node = backward.previous[node];
+		path.push_back(node);
+	}
+	std::reverse(path.begin(), path.end());
+
+	// Odcinki grafu abstrakcyjnego, od koca.
+	for (int current = last; search.previous[current] != NULL_IDX; current = search.previous[current]) {
+		const AbstractEdge& edge = _abstractEdges[search.previous[current]][search.edges[current]];
+		if (edge.path == NULL_IDX) {
+			path.push_back(_entrances[current]);
+		}
+		else {
+			const std::vector<int>& edgePath = _edgePaths[edge.path];
+			path.insert(path.end(), edgePath.rbegin(), edgePath.rend() - 1);
+		}
+	}
+
+	// Odcinek od pocztku do pierwszego wejcia.
+	int first = last;
+	while (search.previous[first] != NULL_IDX) { first = search.previous[first]; }
+	for (int node = _entrances[first]; node != NULL_IDX; node = forward.previous[node]) {
+		path.push_back(node);
+	}
+
+	return true;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+#include "math/Math.h"
+
+struct HierarchicalSearchWorkspace;
+
+// Dwupoziomowa reprezentacja grafu nawigacji wykorzystywana przez HPA*.
+// Wzy s dzielone na kwadratowe klastry. Graf abstrakcyjny tworz wejcia, czyli koce ukw
+// czcych rne klastry. Wejcia tego samego klastra czy najkrtsza cieka wewntrz klastra,
+// wyznaczana podczas budowy grafu i zapamitywana w caoci.
+class HierarchicalGraph {
+public:
+	typedef std::pair<int, float> Arc;
+
+	HierarchicalGraph(const std::vector<Vector2>& positions, const std::vector<std::vector<Arc>>& arcs,
+		float width, float height, float clusterSize);
+
+	// Wyszukuje ciek omijajc ignorowane obszary. Podobnie jak w GameMap::aStar, cieka
+	// zapisywana jest od wza docelowego do pocztkowego. Wynik nie musi by optymalny.
+	bool findPath(int from, int to, const std::vector<common::Circle>& ignoredAreas, std::vector<int>& path) const;
+
+	size_t getClustersCount() const;
+	size_t getEntrancesCount() const;
+
+	static const int NULL_IDX;
+
+private:
+	struct AbstractEdge {
+		int to;
+		float cost;
+		// Indeks cieki w _edgePaths lub NULL_IDX dla uku czcego rne klastry.
+		int path;
+	};
+
+	std::vector<Vector2> _positions;
+	std::vector<std::vector<Arc>> _arcs;
+	std::vector<std::vector<Arc>> _reverseArcs;
+	std::vector<int> _clusters;
+	int _clustersX;
+	int _clustersY;
+	float _clusterSize;
+
+	std::vector<int> _entrances;
+	std::vector<int> _entranceIds;
+	std::vector<std::vector<int>> _clusterEntrances;
+	std::vector<std::vector<AbstractEdge>> _abstractEdges;
+	std::vector<std::vector<int>> _edgePaths;
+
+	int getCluster(const Vector2& position) const;
+	void addEntrance(int node);
+	// Dijkstra ograniczona do klastra wza source, po ukach odwrconych, jeeli reverse == true.
+	void searchCluster(int source, bool reverse, const std::vector<common::Circle>& ignoredAreas, HierarchicalSearchWorkspace& workspace) const;
+	bool isEdgeInIgnoredArea(int from, const AbstractEdge& edge, const std::vector<common::Circle>& ignoredAreas) const;
+};
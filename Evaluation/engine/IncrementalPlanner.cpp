@@ -0,0 +1,201 @@
+#include "IncrementalPlanner.h"
+#include "engine/Navigation.h"
+#include <limits>
+
+const int IncrementalPlanner::NULL_IDX = -1;
+
+bool IncrementalPlanner::Key::operator<(const Key& other) const {
+	return primary < other.primary || (primary == other.primary && secondary < other.secondary);
+}
+
+IncrementalPlanner::IncrementalPlanner(const GameMap* map, int goal)
+	: _map(map), _goal(goal), _start(NULL_IDX), _keyModifier(0), _expandedNodes(0) {
+	
+	const auto& mesh = map->_navigationMesh;
+	size_t n = mesh.size();
+	float infinity = std::numeric_limits<float>::infinity();
+
+	_arcOffsets.reserve(n + 1);
+	_arcOffsets.push_back(0);
+	_reverseArcs.resize(n);
+	for (size_t i = 0; i < n; ++i) {
+		int offset = _arcOffsets.back();
+		int arcsCount = mesh[i].arcs.size();
+		for (int j = 0; j < arcsCount; ++j) {
+			_reverseArcs[mesh[i].arcs[j].first].push_back({ (int)i, offset + j });
+		}
+		_arcOffsets.push_back(offset + arcsCount);
+	}
+
+	_blockedArcs.resize(_arcOffsets.back(), false);
+	_distances.resize(n, infinity);
+	_lookahead.resize(n, infinity);
+	_open.reserve(n);
+}
+
+void IncrementalPlanner::reset(int goal) {
+	float infinity = std::numeric_limits<float>::infinity();
+	_goal = goal;
+	_start = NULL_IDX;
+	_keyModifier = 0;
+	std::fill(_blockedArcs.begin(), _blockedArcs.end(), false);
+	_blockedAreas.clear();
+	std::fill(_distances.begin(), _distances.end(), infinity);
+	std::fill(_lookahead.begin(), _lookahead.end(), infinity);
+	_open.clear();
+}
+
+std::mutex& IncrementalPlanner::getMutex() { return _mutex; }
+
+int IncrementalPlanner::getGoal() const { return _goal; }
+
+const std::vector<common::Circle>& IncrementalPlanner::getBlockedAreas() const { return _blockedAreas; }
+
+size_t IncrementalPlanner::getExpandedNodesCount() const { return _expandedNodes; }
+
+float IncrementalPlanner::getArcCost(int from, int arc) const {
+	return _blockedArcs[arc] ? std::numeric_limits<float>::infinity()
+		: _map->_navigationMesh[from].arcs[arc - _arcOffsets[from]].second;
+}
+
+void IncrementalPlanner::blockArc(int from, int to) {
+	const auto& arcs = _map->_navigationMesh[from].arcs;
+	int offset = _arcOffsets[from];
+	bool changed = false;
+	for (size_t i = 0; i < arcs.size(); ++i) {
+		if (arcs[i].first == to && !_blockedArcs[offset + i]) {
+			_blockedArcs[offset + i] = true;
+			changed = true;
+		}
+	}
+	if (changed) {
+		updateLookahead(from);
+		updateNode(from);
+	}
+}
+
+IncrementalPlanner::Key IncrementalPlanner::calculateKey(int node) const {
+	float distance = common::min(_distances[node], _lookahead[node]);
+	return { distance + _map->estimateDistance(_start, node) + _keyModifier, distance };
+}
+
+// Warto wyprzedzajca wza to najmniejsza suma kosztu uku i odlegoci jego koca od celu.
+void IncrementalPlanner::updateLookahead(int node) {
+	if (node == _goal) { return; }
+	float result = std::numeric_limits<float>::infinity();
+	const auto& arcs = _map->_navigationMesh[node].arcs;
+	int offset = _arcOffsets[node];
+	for (size_t i = 0; i < arcs.size(); ++i) {
+		if (!_blockedArcs[offset + i]) {
+			result = common::min(result, arcs[i].second + _distances[arcs[i].first]);
+		}
+	}
+	_lookahead[node] = result;
+}
+
+// Wze pozostaje w kolejce dopty, dopki jego odlego nie jest zgodna z wartoci wyprzedzajc.
+void IncrementalPlanner::updateNode(int node) {
+	if (_distances[node] != _lookahead[node]) {
+		_open.pushOrUpdate(node, calculateKey(node));
+	}
+	else if (_open.contains(node)) {
+		_open.remove(node);
+	}
+}
+
+void IncrementalPlanner::computeShortestPath() {
+	float infinity = std::numeric_limits<float>::infinity();
+	while (!_open.isEmpty() && (_open.topKey() < calculateKey(_start) || _lookahead[_start] != _distances[_start])) {
+		int node = _open.top();
+		Key oldKey = _open.topKey();
+		Key newKey = calculateKey(node);
+		++_expandedNodes;
+
+		if (oldKey < newKey) {
+			// Klucz wyznaczony przed przesuniciem si obiektu jest nieaktualny.
+			_open.pushOrUpdate(node, newKey);
+		}
+		else if (_distances[node] > _lookahead[node]) {
+			_distances[node] = _lookahead[node];
+			_open.remove(node);
+			for (const ReverseArc& arc : _reverseArcs[node]) {
+				if (arc.from != _goal) {
+					_lookahead[arc.from] = common::min(_lookahead[arc.from], getArcCost(arc.from, arc.arc) + _distances[node]);
+				}
+				updateNode(arc.from);
+			}
+		}
+		else {
+			float oldDistance = _distances[node];
+			_distances[node] = infinity;
+			for (const ReverseArc& arc : _reverseArcs[node]) {
+				if (_lookahead[arc.from] == getArcCost(arc.from, arc.arc) + oldDistance) {
+					updateLookahead(arc.from);
+				}
+				updateNode(arc.from);
+			}
+			updateLookahead(node);
+			updateNode(node);
+		}
+	}
+}
+
+bool IncrementalPlanner::findPath(int start, const std::vector<common::Circle>& newBlockedAreas, std::vector<int>& path) {
+	path.clear();
+	const auto& mesh = _map->_navigationMesh;
+
+	if (_start == NULL_IDX) {
+		_start = start;
+		_lookahead[_goal] = 0;
+		_open.pushOrUpdate(_goal, calculateKey(_goal));
+	}
+	else if (start != _start) {
+		// Przesunicie obiektu zmienia heurystyk wszystkich kluczy w kolejce. Zamiast je przelicza,
+		// zwikszamy skadnik dodawany do nowych kluczy o oszacowanie przebytej drogi.
+		_keyModifier += _map->estimateDistance(_start, start);
+		_start = start;
+	}
+
+	// uki przechodzce przez nowe obszary wyszukiwane s w komrkach siatki nawigacji.
+	// Graf jest skierowany, wic blokowane s oba kierunki kadej pary wzw.
+	std::vector<std::pair<int, int>> blockedArcs;
+	_map->getBlockedArcs(newBlockedAreas, blockedArcs);
+	_blockedAreas.insert(_blockedAreas.end(), newBlockedAreas.begin(), newBlockedAreas.end());
+	for (const auto& arc : blockedArcs) {
+		blockArc(arc.first, arc.second);
+		blockArc(arc.second, arc.first);
+	}
+
+	computeShortestPath();
+
+	if (_distances[_start] == std::numeric_limits<float>::infinity()) { return false; }
+
+	// cieka prowadzi przez ssiadw o najmniejszej sumie kosztu uku i odlegoci od celu.
+	int current = _start;
+	path.push_back(current);
+	while (current != _goal && path.size() <= mesh.size()) {
+		int next = NULL_IDX;
+		float best = std::numeric_limits<float>::infinity();
+		const auto& arcs = mesh[current].arcs;
+		int offset = _arcOffsets[current];
+		for (size_t i = 0; i < arcs.size(); ++i) {
+			float value = getArcCost(current, offset + i) + _distances[arcs[i].first];
+			if (value < best) {
+				best = value;
+				next = arcs[i].first;
+			}
+		}
+		if (next == NULL_IDX) {
+			path.clear();
+			return false;
+		}
+		current = next;
+		path.push_back(current);
+	}
+	if (current != _goal) {
+		path.clear();
+		return false;
+	}
+	std::reverse(path.begin(), path.end());
+	return true;
+}
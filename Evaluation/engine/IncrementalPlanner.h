@@ -0,0 +1,70 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include "math/Math.h"
+#include "engine/IndexedHeap.h"
+
+class GameMap;
+
+// Przyrostowe wyszukiwanie cieki do ustalonego wza docelowego (D* Lite).
+// Wyszukiwanie przebiega od celu do obiektu, dlatego po przemieszczeniu si obiektu i zablokowaniu
+// ukw w jego otoczeniu poprawiane s tylko odlegoci wzw, ktrych dotycz zmiany.
+// Kady obiekt posiada wasny planer. Kolejne zlecenia naprawy cieki obiektu mog jednak trafi
+// do rnych wtkw usugi planowania, dlatego korzystajcy z planera blokuj mutex getMutex().
+class IncrementalPlanner {
+public:
+	IncrementalPlanner(const GameMap* map, int goal);
+
+	// Usuwa stan wyszukiwania i zablokowane obszary, ustalajc nowy wze docelowy.
+	void reset(int goal);
+	std::mutex& getMutex();
+
+	int getGoal() const;
+	const std::vector<common::Circle>& getBlockedAreas() const;
+	// czna liczba wzw zdjtych z kolejki od utworzenia planera.
+	size_t getExpandedNodesCount() const;
+
+	// Blokuje uki przechodzce przez nowe obszary i wyznacza ciek z wza start.
+	// Podobnie jak w GameMap::aStar, cieka zapisywana jest od wza docelowego do pocztkowego.
+	bool findPath(int start, const std::vector<common::Circle>& newBlockedAreas, std::vector<int>& path);
+
+	static const int NULL_IDX;
+
+private:
+	struct Key {
+		float primary;
+		float secondary;
+
+		bool operator<(const Key& other) const;
+	};
+
+	struct ReverseArc {
+		int from;
+		int arc;
+	};
+
+	const GameMap* _map;
+	int _goal;
+	int _start;
+	float _keyModifier;
+	size_t _expandedNodes;
+
+	// uki wza i le w przedziale [_arcOffsets[i], _arcOffsets[i + 1]) wsplnej numeracji.
+	std::vector<int> _arcOffsets;
+	std::vector<std::vector<ReverseArc>> _reverseArcs;
+	std::vector<bool> _blockedArcs;
+	std::vector<common::Circle> _blockedAreas;
+
+	std::vector<float> _distances;
+	std::vector<float> _lookahead;
+	IndexedHeap<Key> _open;
+	std::mutex _mutex;
+
+	float getArcCost(int from, int arc) const;
+	void blockArc(int from, int to);
+	Key calculateKey(int node) const;
+	void updateLookahead(int node);
+	void updateNode(int node);
+	void computeShortestPath();
+};
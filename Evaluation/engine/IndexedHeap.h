@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Kopiec binarny typu min przechowujcy elementy o indeksach 0..n-1.
+// Pozycja kadego elementu jest zapamitywana, co umoliwia zmniejszenie klucza w czasie O(logn).
+template <typename Key> class IndexedHeap {
+
+public:
+	static const int NULL_POSITION;
+
+	IndexedHeap();
+
+	// Przygotowuje kopiec dla elementw o indeksach mniejszych od capacity.
+	void reserve(size_t capacity);
+
+	// Usuwa wszystkie elementy. Zoono O(k), gdzie k to liczba elementw w kopcu.
+	void clear();
+
+	bool isEmpty() const;
+	size_t getSize() const;
+	bool contains(int item) const;
+
+	// Dodaje element lub zmniejsza jego klucz, jeeli element ju znajduje si w kopcu.
+	void pushOrDecrease(int item, Key key);
+	// Dodaje element lub zmienia jego klucz na dowoln warto.
+	void pushOrUpdate(int item, Key key);
+	void remove(int item);
+
+	int top() const;
+	Key topKey() const;
+	int pop();
+
+private:
+	struct HeapEntry {
+		int item;
+		Key key;
+	};
+
+	std::vector<HeapEntry> _entries;
+	std::vector<int> _positions;
+
+	void siftUp(size_t position);
+	void siftDown(size_t position);
+	void place(size_t position, const HeapEntry& entry);
+};
+
+template <typename Key> const int IndexedHeap<Key>::NULL_POSITION = -1;
+
+template <typename Key> IndexedHeap<Key>::IndexedHeap() {}
+
+template <typename Key> void IndexedHeap<Key>::reserve(size_t capacity) {
+	if (_positions.size() < capacity) {
+		_positions.resize(capacity, NULL_POSITION);
+		_entries.reserve(capacity);
+	}
+}
+
+template <typename Key> void IndexedHeap<Key>::clear() {
+	for (const HeapEntry& entry : _entries) {
+		_positions[entry.item] = NULL_POSITION;
+	}
+	_entries.clear();
+}
+
+template <typename Key> bool IndexedHeap<Key>::isEmpty() const { return _entries.empty(); }
+
+template <typename Key> size_t IndexedHeap<Key>::getSize() const { return _entries.size(); }
+
+template <typename Key> bool IndexedHeap<Key>::contains(int item) const { return _positions[item] != NULL_POSITION; }
+
+template <typename Key> void IndexedHeap<Key>::pushOrDecrease(int item, Key key) {
+	int position = _positions[item];
+	if (position == NULL_POSITION) {
+		_entries.push_back({ item, key });
+		_positions[item] = _entries.size() - 1;
+		siftUp(_entries.size() - 1);
+	}
+	else if (key < _entries[position].key) {
+		_entries[position].key = key;
+		siftUp(position);
+	}
+}
+
+template <typename Key> void IndexedHeap<Key>::pushOrUpdate(int item, Key key) {
+	int position = _positions[item];
+	if (position == NULL_POSITION) {
+		pushOrDecrease(item, key);
+	}
+	else {
+		_entries[position].key = key;
+		siftUp(position);
+		siftDown(_positions[item]);
+	}
+}
+
+template <typename Key> void IndexedHeap<Key>::remove(int item) {
+	size_t position = _positions[item];
+	_positions[item] = NULL_POSITION;
+	HeapEntry last = _entries.back();
+	_entries.pop_back();
+	if (position < _entries.size()) {
+		place(position, last);
+		siftUp(position);
+		siftDown(_positions[last.item]);
+	}
+}
+
+template <typename Key> int IndexedHeap<Key>::top() const { return _entries.front().item; }
+
+template <typename Key> Key IndexedHeap<Key>::topKey() const { return _entries.front().key; }
+
+template <typename Key> int IndexedHeap<Key>::pop() {
+	int result = _entries.front().item;
+	_positions[result] = NULL_POSITION;
+	HeapEntry last = _entries.back();
+	_entries.pop_back();
+	if (!_entries.empty()) {
+		place(0, last);
+		siftDown(0);
+	}
+	return result;
+}
+
+template <typename Key> void IndexedHeap<Key>::place(size_t position, const HeapEntry& entry) {
+	_entries[position] = entry;
+	_positions[entry.item] = position;
+}
+
+template <typename Key> void IndexedHeap<Key>::siftUp(size_t position) {
+	HeapEntry entry = _entries[position];
+	while (position > 0) {
+		size_t parent = (position - 1) / 2;
+		if (!(entry.key < _entries[parent].key)) { break; }
+		place(position, _entries[parent]);
+		position = parent;
+	}
+	place(position, entry);
+}
+
+template <typename Key> void IndexedHeap<Key>::siftDown(size_t position) {
+	size_t n = _entries.size();
+	HeapEntry entry = _entries[position];
+	while (true) {
+		size_t child = 2 * position + 1;
+		if (child >= n) { break; }
+		if (child + 1 < n && _entries[child + 1].key < _entries[child].key) { ++child; }
+		if (!(_entries[child].key < entry.key)) { break; }
+		place(position, _entries[child]);
+		position = child;
+	}
+	place(position, entry);
+}
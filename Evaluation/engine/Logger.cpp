@@ -1,76 +1,147 @@
 #include "Logger.h"
-#include "engine/CommonFunctions.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
 
-bool Logger::_isLogging = true;
+std::atomic<bool> Logger::_isLogging(true);
+std::atomic<unsigned int> Logger::_levelMask(LOG_DEBUG | LOG_INFO | LOG_WARNING | LOG_ERROR);
+std::atomic<unsigned int> Logger::_categoryMask(~0u);
+std::atomic<size_t> Logger::_droppedCount(0);
 
-std::vector<String> Logger::_logs = std::vector<String>();
+std::vector<std::unique_ptr<Logger::LogBuffer>> Logger::_buffers;
+std::mutex Logger::_buffersMutex;
 
-std::mutex Logger::_mtx;
+std::thread Logger::_writer;
+std::mutex Logger::_writerMutex;
+std::condition_variable Logger::_writerCondition;
+bool Logger::_isWriterStopping = false;
 
-std::vector<String> Logger::loggerIgnore = std::vector<String>({
-	"updateOrientation",
-	"updateMovement",
-	"setPreferredVelocityAndSafeGoal",
-	"updateSpotting",
-	"getActorsInViewAngle",
-	"getVelocityObstacles",
-	"computeCandidates",
-	"selectVelocity",
-	"checkMovement",
-	"updateCurrentAction",
-	"updateMovement",
-	"updateWeapons"
-	});
+Logger::LogBuffer::LogBuffer() : _entries(CAPACITY), _head(0), _tail(0) {}
 
-size_t Logger::_notIgnoredIdx = loggerIgnore.size();
-
-bool Logger::loggerIgnores(const String& name) {
-	return common::indexOf<String>(loggerIgnore, name) != _notIgnoredIdx;
+bool Logger::LogBuffer::push(LogEntry&& entry) {
+	size_t head = _head.load(std::memory_order_relaxed);
+	if (head - _tail.load(std::memory_order_acquire) == CAPACITY) {
+		return false;
+	}
+	_entries[head % CAPACITY] = std::move(entry);
+	_head.store(head + 1, std::memory_order_release);
+	return true;
 }
 
-void Logger::pushLog(const String& text) {
-		_mtx.lock();
-		_logs.push_back(text);
-		_mtx.unlock();
+void Logger::LogBuffer::drain(std::vector<LogEntry>& result) {
+	size_t tail = _tail.load(std::memory_order_relaxed);
+	size_t head = _head.load(std::memory_order_acquire);
+	for (; tail != head; ++tail) {
+		result.push_back(std::move(_entries[tail % CAPACITY]));
+	}
+	_tail.store(tail, std::memory_order_release);
 }
 
-void Logger::log(const String& text) { 
-	if (_isLogging) {
-		pushLog(text);
+// Bufor jest tworzony przy pierwszym komunikacie wtku i pozostaje w rejestrze do koca dziaania programu,
+// dziki czemu komunikaty zakoczonych wtkw rwnie zostan zapisane.
+Logger::LogBuffer* Logger::getThreadBuffer() {
+	thread_local LogBuffer* buffer = nullptr;
+	if (buffer == nullptr) {
+		std::lock_guard<std::mutex> lock(_buffersMutex);
+		_buffers.push_back(std::unique_ptr<LogBuffer>(new LogBuffer()));
+		buffer = _buffers.back().get();
 	}
+	return buffer;
 }
 
-void Logger::logIfNotIgnored(const String& key, const String& text) {
-	if (_isLogging && !loggerIgnores(key)) {
-		pushLog(text);
+void Logger::log(LogLevel level, LogCategory category, const String& text) {
+	LogEntry entry;
+	entry.time = std::chrono::steady_clock::now().time_since_epoch().count();
+	entry.level = level;
+	entry.category = category;
+	entry.text = text;
+	if (!getThreadBuffer()->push(std::move(entry))) {
+		_droppedCount.fetch_add(1, std::memory_order_relaxed);
 	}
 }
 
-void Logger::printLogs() { 
-	if (_isLogging) {
-		_mtx.lock();
-		for (String s : _logs) {
-			std::cout << s << std::endl;
+void Logger::initialize() {
+	if (_writer.joinable()) { return; }
+	_levelMask = Config.LogLevelMask;
+	_categoryMask = Config.LogCategoryMask;
+	_isWriterStopping = false;
+	_writer = std::thread(&Logger::runWriter);
+}
+
+void Logger::dispose() {
+	if (_writer.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(_writerMutex);
+			_isWriterStopping = true;
 		}
-		_mtx.unlock();
+		_writerCondition.notify_one();
+		_writer.join();
 	}
 }
 
-void Logger::clear() {
-	_mtx.lock();
-	_logs.clear();
-	_mtx.unlock();
+void Logger::runWriter() {
+	std::ofstream file;
+	if (Config.LogOutput != "-") {
+		file.open(Config.LogOutput, Config.LogBinary ? std::ios::out | std::ios::binary : std::ios::out);
+	}
+	std::ostream& output = file.is_open() ? file : std::cout;
+
+	std::vector<LogEntry> entries;
+	bool isStopping = false;
+	while (!isStopping) {
+		{
+			std::unique_lock<std::mutex> lock(_writerMutex);
+			_writerCondition.wait_for(lock, std::chrono::milliseconds(50), [] { return _isWriterStopping; });
+			isStopping = _isWriterStopping;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(_buffersMutex);
+			for (auto& buffer : _buffers) {
+				buffer->drain(entries);
+			}
+		}
+		writeEntries(entries, output);
+		entries.clear();
+	}
+	output.flush();
 }
 
-void Logger::startLogging() {
-	_isLogging = true; 
-	_logs.clear(); 
+void Logger::writeEntries(std::vector<LogEntry>& entries, std::ostream& output) {
+	// Komunikaty z rnych wtkw s porzdkowane wedug czasu zgoszenia.
+	std::stable_sort(entries.begin(), entries.end(),
+		[](const LogEntry& entry1, const LogEntry& entry2) { return entry1.time < entry2.time; });
+
+	size_t dropped = _droppedCount.exchange(0, std::memory_order_relaxed);
+	if (dropped > 0) {
+		LogEntry marker;
+		marker.time = std::chrono::steady_clock::now().time_since_epoch().count();
+		marker.level = LOG_WARNING;
+		marker.category = 0;
+		marker.text = "Logger: " + std::to_string(dropped) + " messages dropped.";
+		entries.push_back(std::move(marker));
+	}
+
+	for (const LogEntry& entry : entries) {
+		if (Config.LogBinary) { writeRecord(entry, output); }
+		else { output << entry.text << '\n'; }
+	}
+	if (!entries.empty()) {
+		output.flush();
+	}
 }
 
-void Logger::stopLogging() {
-	_isLogging = false;
+void Logger::writeRecord(const LogEntry& entry, std::ostream& output) {
+	unsigned int length = entry.text.size();
+	output.write(reinterpret_cast<const char*>(&entry.time), sizeof(entry.time));
+	output.write(reinterpret_cast<const char*>(&entry.level), sizeof(entry.level));
+	output.write(reinterpret_cast<const char*>(&entry.category), sizeof(entry.category));
+	output.write(reinterpret_cast<const char*>(&length), sizeof(length));
+	output.write(entry.text.data(), length);
 }
 
-bool Logger::isLogging() {
-	return _isLogging;
-}
\ No newline at end of file
+void Logger::startLogging() { _isLogging = true; }
+
+void Logger::stopLogging() { _isLogging = false; }
+
+bool Logger::isLogging() { return _isLogging; }
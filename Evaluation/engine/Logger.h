@@ -1,29 +1,112 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
-#include <mutex>
 #include "main/Configuration.h"
 
+// Poziomy i kategorie komunikatw s bitami masek Config.LogLevelMask i Config.LogCategoryMask.
+enum LogLevel {
+	LOG_DEBUG = 1,
+	LOG_INFO = 2,
+	LOG_WARNING = 4,
+	LOG_ERROR = 8
+};
+
+enum LogCategory {
+	LOG_GENERAL = 1,
+	LOG_ACTIONS = 2,
+	LOG_COMBAT = 4,
+	LOG_TRIGGERS = 8,
+	LOG_RESOURCES = 16,
+	LOG_PERFORMANCE = 32
+};
+
+// Poziomy komunikatw pozostawiane w kodzie wynikowym. Wywoania LOG o pozostaych poziomach
+// s usuwane przez kompilator razem z wyraeniem tworzcym tre komunikatu.
+#ifndef LOG_COMPILED_LEVELS
+#ifdef _DEBUG
+#define LOG_COMPILED_LEVELS (LOG_DEBUG | LOG_INFO | LOG_WARNING | LOG_ERROR)
+#else
+#define LOG_COMPILED_LEVELS (LOG_INFO | LOG_WARNING | LOG_ERROR)
+#endif
+#endif
+
+// Tre komunikatu jest wyznaczana tylko wtedy, gdy komunikat zostanie zapisany.
+#define LOG(level, category, text) \
+	do { \
+		if (((level) & LOG_COMPILED_LEVELS) && Logger::isEnabled(level, category)) { \
+			Logger::log(level, category, text); \
+		} \
+	} while (false)
+
+// Komunikaty trafiaj do bufora cyklicznego wtku, ktry je zgosi (jeden producent, jeden konsument),
+// skd co pewien czas odbiera je wtek zapisujcy. Przy zapenionym buforze komunikat jest pomijany.
+// W trybie binarnym (Config.LogBinary) kady komunikat zapisywany jest jako rekord:
+// czas (8 bajtw), poziom (1), kategoria (2), dugo treci (4), tre bez znaku koca.
+// Informacja o pominitych komunikatach zapisywana jest w obu trybach; w trybie binarnym jako rekord
+// o poziomie LOG_WARNING i kategorii 0.
 class Logger {
 public:
-	static std::vector<String> loggerIgnore;
+	// Uruchamia wtek zapisujcy zgodnie z konfiguracj. Komunikaty zgoszone wczeniej s buforowane.
+	static void initialize();
+	// Zapisuje pozostae komunikaty i zatrzymuje wtek zapisujcy.
+	static void dispose();
+
+	static void log(LogLevel level, LogCategory category, const String& text);
+
+	static bool isEnabled(LogLevel level, LogCategory category) {
+		return _isLogging.load(std::memory_order_relaxed)
+			&& (_levelMask.load(std::memory_order_relaxed) & level) != 0
+			&& (_categoryMask.load(std::memory_order_relaxed) & category) != 0;
+	}
 
-	static void log(const String& text);
-	static void logIfNotIgnored(const String& key, const String& text);
-	static void printLogs();
-	static void clear();
 	static bool isLogging();
-	static bool loggerIgnores(const String& name);
 	static void startLogging();
 	static void stopLogging();
 
 private:
-	static std::vector<String> _logs;
-	static bool _isLogging;
-	static std::mutex _mtx;
-	static size_t _notIgnoredIdx;
+	struct LogEntry {
+		unsigned long long time;
+		unsigned char level;
+		unsigned short category;
+		String text;
+	};
+
+	class LogBuffer {
+	public:
+		LogBuffer();
+		bool push(LogEntry&& entry);
+		void drain(std::vector<LogEntry>& result);
+
+	private:
+		static const size_t CAPACITY = 1024;
+
+		std::vector<LogEntry> _entries;
+		std::atomic<size_t> _head;
+		std::atomic<size_t> _tail;
+	};
+
+	static std::atomic<bool> _isLogging;
+	static std::atomic<unsigned int> _levelMask;
+	static std::atomic<unsigned int> _categoryMask;
+	static std::atomic<size_t> _droppedCount;
+
+	static std::vector<std::unique_ptr<LogBuffer>> _buffers;
+	static std::mutex _buffersMutex;
+
+	static std::thread _writer;
+	static std::mutex _writerMutex;
+	static std::condition_variable _writerCondition;
+	static bool _isWriterStopping;
 
-	static void pushLog(const String& text);
+	static LogBuffer* getThreadBuffer();
+	static void runWriter();
+	static void writeEntries(std::vector<LogEntry>& entries, std::ostream& output);
+	static void writeRecord(const LogEntry& entry, std::ostream& output);
 };
@@ -0,0 +1,97 @@
+#include "engine/MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile() : _data(nullptr), _size(0), _file(INVALID_HANDLE_VALUE), _mapping(nullptr) {}
+
+bool MappedFile::open(const std::string& filename) {
+	close();
+
+	_file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (_file == INVALID_HANDLE_VALUE) { return false; }
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(_file, &size) || size.QuadPart == 0) {
+		close();
+		return false;
+	}
+
+	_mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (_mapping == nullptr) {
+		close();
+		return false;
+	}
+
+	_data = static_cast<const char*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+	if (_data == nullptr) {
+		close();
+		return false;
+	}
+	_size = (size_t)size.QuadPart;
+	return true;
+}
+
+void MappedFile::close() {
+	if (_data != nullptr) { UnmapViewOfFile(_data); }
+	if (_mapping != nullptr) { CloseHandle(_mapping); }
+	if (_file != INVALID_HANDLE_VALUE) { CloseHandle(_file); }
+	_data = nullptr;
+	_size = 0;
+	_mapping = nullptr;
+	_file = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+MappedFile::MappedFile() : _data(nullptr), _size(0), _file(-1) {}
+
+bool MappedFile::open(const std::string& filename) {
+	close();
+
+	_file = ::open(filename.c_str(), O_RDONLY);
+	if (_file < 0) { return false; }
+
+	struct stat status;
+	if (fstat(_file, &status) != 0 || status.st_size == 0) {
+		close();
+		return false;
+	}
+
+	void* data = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, _file, 0);
+	if (data == MAP_FAILED) {
+		close();
+		return false;
+	}
+	_data = static_cast<const char*>(data);
+	_size = status.st_size;
+	return true;
+}
+
+void MappedFile::close() {
+	if (_data != nullptr) { munmap(const_cast<char*>(_data), _size); }
+	if (_file >= 0) { ::close(_file); }
+	_data = nullptr;
+	_size = 0;
+	_file = -1;
+}
+
+#endif
+
+MappedFile::~MappedFile() { close(); }
+
+bool MappedFile::isOpen() const { return _data != nullptr; }
+
+const char* MappedFile::getData() const { return _data; }
+
+size_t MappedFile::getSize() const { return _size; }
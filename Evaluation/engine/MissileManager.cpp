@@ -5,62 +5,86 @@
 #include "engine//WeaponLoader.h"
 #include "math/Math.h"
 #include "actions//Die.h"
+#include <algorithm>
+#include <limits>
 
-MissileManager::MissileManager() {
-	_capacity = DEFAULT_CAPACITY;
-	_count = 0;
-	_missiles = new Missile[_capacity];
-}
+const int MissileManager::NULL_WEAPON_ID = -1;
 
-MissileManager::~MissileManager() {
-	delete[] _missiles;
+MissileManager::MissileManager() : _workers(Config.MissileThreads) {
+	_owners.reserve(DEFAULT_CAPACITY);
+	_origins.reserve(DEFAULT_CAPACITY);
+	_directions.reserve(DEFAULT_CAPACITY);
+	_targets.reserve(DEFAULT_CAPACITY);
+	_weaponIds.reserve(DEFAULT_CAPACITY);
+	_speeds.reserve(DEFAULT_CAPACITY);
+	_lengths.reserve(DEFAULT_CAPACITY);
+	_timesFired.reserve(DEFAULT_CAPACITY);
+	_timesHit.reserve(DEFAULT_CAPACITY);
+	_isActive.reserve(DEFAULT_CAPACITY);
+	_isTargetReached.reserve(DEFAULT_CAPACITY);
+	_frontPositions.reserve(DEFAULT_CAPACITY);
+	_backPositions.reserve(DEFAULT_CAPACITY);
+	_wallDistances.reserve(DEFAULT_CAPACITY);
+	_wallHitPoints.reserve(DEFAULT_CAPACITY);
 }
 
-const WeaponInfo& getWeaponInfo(const String& weaponName) { return MissileManager::getWeaponInfo(weaponName); }
+MissileManager::~MissileManager() {}
 
-Segment getMissileLine(const Missile& missile, const GameTime& time) {
-	Vector2 direction = (missile.target - missile.origin).normal();
-	auto weaponInfo = getWeaponInfo(missile.weaponType);
-	float front = weaponInfo.missileSpeed * (time - missile.timeFired) / 1000000;
-	return Segment(missile.origin + direction * front, missile.origin + direction * common::max(front - weaponInfo.missileLength, 0));
-}
+const WeaponInfo& getWeaponInfo(const String& weaponName) { return MissileManager::getWeaponInfo(weaponName); }
 
 bool MissileManager::_weaponInfoInitialized = false;
 std::map<String, WeaponInfo> MissileManager::_weaponInfo = std::map<String, WeaponInfo>();
+std::vector<const WeaponInfo*> MissileManager::_weaponsById = std::vector<const WeaponInfo*>();
+
+void MissileManager::initializeMissile(MissileOwner* owner, const Vector2& position, const Vector2& target, int weaponId, GameTime time) {
+	int i = getNextIndex();
+	const WeaponInfo& weaponInfo = getWeaponInfo(weaponId);
+	Vector2 origin = position + ((target - position).normal() * Config.MissileInitialDistance);
+	_owners[i] = owner;
+	_origins[i] = origin;
+	_directions[i] = (target - origin).normal();
+	_targets[i] = target;
+	_weaponIds[i] = weaponId;
+	_speeds[i] = weaponInfo.missileSpeed;
+	_lengths[i] = weaponInfo.missileLength;
+	_timesFired[i] = time;
+	_isActive[i] = true;
+	_isTargetReached[i] = false;
+	_frontPositions[i] = origin;
+	_backPositions[i] = origin;
 
-void MissileManager::initializeMissile(int missileIndex, MissileOwner* owner, const Vector2& position, const Vector2& target, GameTime time) {
-	Missile& missile = _missiles[missileIndex];
-	missile.owner = owner;
-	missile.origin = position + ((target - position).normal() * Config.MissileInitialDistance);
-	missile.target = target;
-	missile.timeFired = time;
-	missile.weaponType = owner->getCurrentWeapon();
-	missile.isActive = true;
-	missile.isTargetReached = false;
-	missile.frontPosition = missile.origin;
-	missile.backPosition = missile.origin;
+	Vector2 wallHitPoint;
+	float range = sqrtf(common::sqr(_map->getWidth()) + common::sqr(_map->getHeight()));
+	if (_map->raycastStatic(Segment(origin, origin + _directions[i] * range), wallHitPoint)) {
+		_wallDistances[i] = common::distance(origin, wallHitPoint);
+		_wallHitPoints[i] = wallHitPoint;
+	}
+	else {
+		_wallDistances[i] = std::numeric_limits<float>::max();
+	}
 }
 
 void MissileManager::shootAt(MissileOwner* owner, const Vector2& target, GameTime time) {
 	Vector2 pos = owner->getPosition();
-	if (common::sqDist(pos, target) > common::sqr(Config.MissileInitialDistance)) {
-		const WeaponInfo& weaponInfo = getWeaponInfo(owner->getCurrentWeapon());
-		if (weaponInfo.missilesNumber == 1) { initializeMissile(getNextIndex(), owner, pos, target, time); }
+	int weaponId = owner->getCurrentWeaponId();
+	if (weaponId != NULL_WEAPON_ID && common::sqDist(pos, target) > common::sqr(Config.MissileInitialDistance)) {
+		const WeaponInfo& weaponInfo = getWeaponInfo(weaponId);
+		if (weaponInfo.missilesNumber == 1) { initializeMissile(owner, pos, target, weaponId, time); }
 		else {
 			Vector2 missileTarget = common::rotatePoint(target, pos, -weaponInfo.fireAngle / 2);
-			initializeMissile(getNextIndex(), owner, pos, missileTarget, time);
+			initializeMissile(owner, pos, missileTarget, weaponId, time);
 			float angle = weaponInfo.fireAngle / (weaponInfo.missilesNumber - 1);
 			float valCos = cosf(angle), valSin = sinf(angle);
 			for (int i = 1; i < weaponInfo.missilesNumber; ++i) {
 				missileTarget = common::rotatePoint(missileTarget, pos, valCos, valSin);
-				initializeMissile(getNextIndex(), owner, pos, missileTarget, time);
+				initializeMissile(owner, pos, missileTarget, weaponId, time);
 			}
 		}
 	}
 }
 
-void MissileManager::invokeDamage(Missile& missile, const Vector2& point) {
-	auto weaponInfo = getWeaponInfo(missile.weaponType);
+void MissileManager::invokeDamage(int missileIndex, const Vector2& point) {
+	const WeaponInfo& weaponInfo = getWeaponInfo(_weaponIds[missileIndex]);
 	float radius = weaponInfo.damageRadius;
 	std::vector<Destructible*> potentialTargets = _map->checkCollisionDestructible(point, radius);
 	for (Destructible* entity : potentialTargets) {			
@@ -69,74 +93,110 @@ void MissileManager::invokeDamage(Missile& missile, const Vector2& point) {
 			if (sqDist <= maxSqDist) {
 				entity->recieveDamage(weaponInfo.minDamage + (1 - sqDist / maxSqDist) * (weaponInfo.maxDamage - weaponInfo.minDamage)); 
 				if (entity->wasDestroyed()) {
-					missile.owner->registerKill(entity);
+					_owners[missileIndex]->registerKill(entity);
 					entity->onDestroy();
 				}
 		}
 	}
 }
 
-void MissileManager::missileHit(Missile& missile, const Vector2& point, GameTime time) {
-	missile.isTargetReached = true;
-	missile.timeHit = time;
-	invokeDamage(missile, point);
+void MissileManager::missileHit(int missileIndex, const Vector2& point, GameTime time, MissileEvents& events) {
+	_isTargetReached[missileIndex] = true;
+	_timesHit[missileIndex] = time;
+	events.hits.push_back({ missileIndex, point });
 }
 
 void MissileManager::update(GameTime time) {
-	for (int i = 0; i < _count; ++i) {
-		Missile& missile = _missiles[i];
-		if (missile.isActive) {
-			Segment missileSegment = getMissileLine(missile, time);
-			Vector2 backPositionOld = missile.backPosition;
-			missile.backPosition = missileSegment.to;
-
-			if (missile.isTargetReached) {
-				//missile.isActive = false;
-				if (common::sqDist(missile.origin, missile.frontPosition)
-					< common::sqDist(missile.origin, missile.backPosition)) {
-					missile.backPosition = missile.frontPosition;
-					const WeaponInfo& weaponInfo = getWeaponInfo(missile.weaponType);
-					if (!weaponInfo.explodes || time - missile.timeHit > 1000000 * weaponInfo.damageRadius / weaponInfo.explosionSpeed) {
-						missile.isActive = false;
-					}
-				}
+	int n = _isActive.size();
+
+	// Odlegoci wyznaczane dla wszystkich miejsc, bez rozgazie i odwoa do opisu broni.
+	_frontDistances.resize(n);
+	_backDistances.resize(n);
+	for (int i = 0; i < n; ++i) {
+		float front = _speeds[i] * (time - _timesFired[i]) / 1000000;
+		_frontDistances[i] = front;
+		_backDistances[i] = common::max(front - _lengths[i], 0);
+	}
+
+	_events.resize(_workers.getConcurrency());
+	_workers.parallelFor(n, BATCH_SIZE, [this, time](size_t i, size_t worker) {
+		if (_isActive[i]) {
+			stepMissile(i, time, _events[worker]);
+		}
+	});
+	applyEvents();
+}
+
+void MissileManager::stepMissile(int i, GameTime time, MissileEvents& events) {
+	Vector2 origin = _origins[i];
+	Vector2 backPositionOld = _backPositions[i];
+	_backPositions[i] = origin + _directions[i] * _backDistances[i];
+
+	if (_isTargetReached[i]) {
+		if (common::sqDist(origin, _frontPositions[i]) < common::sqDist(origin, _backPositions[i])) {
+			_backPositions[i] = _frontPositions[i];
+			const WeaponInfo& weaponInfo = getWeaponInfo(_weaponIds[i]);
+			if (!weaponInfo.explodes || time - _timesHit[i] > 1000000 * weaponInfo.damageRadius / weaponInfo.explosionSpeed) {
+				_isActive[i] = false;
+				events.expired.push_back(i);
 			}
-			else {
-				missile.frontPosition = missileSegment.from;
-				Segment extendedSegment(backPositionOld, missile.frontPosition);
-				auto possibleColliders = _map->checkCollision(extendedSegment);
-				
-				for (DynamicEntity* entity : possibleColliders) {
-					if (entity->isSolid()) {
-						auto collisionResult = common::testCircleAndSegment(common::Circle{ entity->getPosition(), entity->getRadius() }, extendedSegment);
-						if (collisionResult.pointsFound == 1) {
-							missileHit(missile, collisionResult.first, time);
-						}
-						else if (collisionResult.pointsFound == 2) {
-							missileHit(missile, 
-								common::sqDist(backPositionOld, collisionResult.first)
-								< common::sqDist(backPositionOld, collisionResult.second)
-								? collisionResult.first
-								: collisionResult.second, time);
-						}
-					}
+		}
+	}
+	else {
+		// Odcinek pokonany w tej klatce koczy si najpniej na cianie.
+		bool isWallReached = _frontDistances[i] >= _wallDistances[i];
+		_frontPositions[i] = isWallReached ? _wallHitPoints[i] : origin + _directions[i] * _frontDistances[i];
+		Segment extendedSegment(backPositionOld, _frontPositions[i]);
+		auto possibleColliders = _map->checkCollision(extendedSegment);
+		
+		for (DynamicEntity* entity : possibleColliders) {
+			if (entity->isSolid()) {
+				auto collisionResult = common::testCircleAndSegment(common::Circle{ entity->getPosition(), entity->getRadius() }, extendedSegment);
+				if (collisionResult.pointsFound == 1) {
+					missileHit(i, collisionResult.first, time, events);
 				}
-
-				if (!missile.isTargetReached) {
-					Vector2 wallHitPoint;
-					if (_map->raycastStatic(Segment(missile.origin, missile.frontPosition), wallHitPoint)) {
-						missile.frontPosition = wallHitPoint;
-						missileHit(missile, wallHitPoint, time);
-					}
-					else if (getWeaponInfo(missile.weaponType).stopsAtTarget
-						&& (missile.frontPosition - missile.origin).lengthSquared()
-						> (missile.target - missile.origin).lengthSquared()) {
-						missileHit(missile, missile.target, time);
-					}
+				else if (collisionResult.pointsFound == 2) {
+					missileHit(i, 
+						common::sqDist(backPositionOld, collisionResult.first)
+						< common::sqDist(backPositionOld, collisionResult.second)
+						? collisionResult.first
+						: collisionResult.second, time, events);
 				}
 			}
 		}
+
+		if (!_isTargetReached[i]) {
+			if (isWallReached) {
+				missileHit(i, _wallHitPoints[i], time, events);
+			}
+			else if (getWeaponInfo(_weaponIds[i]).stopsAtTarget
+				&& (_frontPositions[i] - origin).lengthSquared() > (_targets[i] - origin).lengthSquared()) {
+				missileHit(i, _targets[i], time, events);
+			}
+		}
+	}
+}
+
+// Zdarzenia jednego pocisku pochodz zawsze z jednego wtku, wic stabilne sortowanie wedug indeksu
+// daje t sam kolejno obrae niezalenie od podziau pracy midzy wtki.
+void MissileManager::applyEvents() {
+	_hits.clear();
+	_expired.clear();
+	for (MissileEvents& events : _events) {
+		_hits.insert(_hits.end(), events.hits.begin(), events.hits.end());
+		_expired.insert(_expired.end(), events.expired.begin(), events.expired.end());
+		events.hits.clear();
+		events.expired.clear();
 	}
+
+	std::stable_sort(_hits.begin(), _hits.end(),
+		[](const MissileHit& hit1, const MissileHit& hit2) { return hit1.missileIndex < hit2.missileIndex; });
+	for (const MissileHit& hit : _hits) {
+		invokeDamage(hit.missileIndex, hit.point);
+	}
+
+	std::sort(_expired.begin(), _expired.end());
+	_freeIndices.insert(_freeIndices.end(), _expired.begin(), _expired.end());
 }
 
 void MissileManager::initialize(GameMap* map) {
@@ -147,32 +207,41 @@ void MissileManager::initialize(GameMap* map) {
 	}
 }
 
-
 int MissileManager::getNextIndex() {
-	// Najpierw prbujemy przydzieli pierwszy dostpny indeks
-	for (int i = 0; i < _count; ++i) {
-		if (!_missiles[i].isActive) {
-			return i;
-		}
+	if (!_freeIndices.empty()) {
+		int index = _freeIndices.back();
+		_freeIndices.pop_back();
+		return index;
 	}
-	// Jeli nie jest to moliwe, zwikszamy pul wykorzystywanych indeksw.
-	// W ostatecznoci poszerzamy tablic.
-	if (_count == _capacity) {
-		_capacity += RESIZE_CAPACITY;
-		Missile* tempArray = new Missile[_capacity];
-		memcpy(tempArray, _missiles, sizeof(Missile) * _count);
-		delete[] _missiles;
-		_missiles = tempArray;
-	}
-	return _count++;
+	// Tablice rosn geometrycznie (push_back), bez przenoszenia pociskw midzy miejscami.
+	_owners.push_back(nullptr);
+	_origins.push_back(Vector2());
+	_directions.push_back(Vector2());
+	_targets.push_back(Vector2());
+	_weaponIds.push_back(NULL_WEAPON_ID);
+	_speeds.push_back(0);
+	_lengths.push_back(0);
+	_timesFired.push_back(0);
+	_timesHit.push_back(0);
+	_isActive.push_back(false);
+	_isTargetReached.push_back(false);
+	_frontPositions.push_back(Vector2());
+	_backPositions.push_back(Vector2());
+	_wallDistances.push_back(0);
+	_wallHitPoints.push_back(Vector2());
+	return _isActive.size() - 1;
 }
 
 std::vector<Missile> MissileManager::getMissiles() const {
 	std::vector<Missile> result;
-	result.reserve(_count);
-	for (int i = 0; i < _count; ++i) {
-		if (_missiles[i].isActive && common::sqDist(_missiles[i].backPosition, _missiles[i].frontPosition) > common::EPSILON) {
-			result.push_back(_missiles[i]);
+	int n = _isActive.size();
+	for (int i = 0; i < n; ++i) {
+		if (_isActive[i] && common::sqDist(_backPositions[i], _frontPositions[i]) > common::EPSILON) {
+			Missile missile;
+			missile.frontPosition = _frontPositions[i];
+			missile.backPosition = _backPositions[i];
+			missile.weaponId = _weaponIds[i];
+			result.push_back(missile);
 		}
 	}
 	return result;
@@ -180,19 +249,40 @@ std::vector<Missile> MissileManager::getMissiles() const {
 
 std::vector<common::Ring> MissileManager::getExplosions(GameTime time) const {
 	std::vector<common::Ring> result;
-	for (int i = 0; i < _count; ++i) {
-		const WeaponInfo& weaponInfo = getWeaponInfo(_missiles[i].weaponType);
-		if (_missiles[i].isActive && _missiles[i].isTargetReached) {
-			float r = (time - _missiles[i].timeHit) * weaponInfo.explosionSpeed / 1000000 * 3 / 2;
+	int n = _isActive.size();
+	for (int i = 0; i < n; ++i) {
+		if (_isActive[i] && _isTargetReached[i]) {
+			const WeaponInfo& weaponInfo = getWeaponInfo(_weaponIds[i]);
+			float r = (time - _timesHit[i]) * weaponInfo.explosionSpeed / 1000000 * 3 / 2;
 			float r1 = common::max(r - weaponInfo.damageRadius / 2, 0);
 			float r2 = common::min(r, weaponInfo.damageRadius);
-			result.push_back({ _missiles[i].frontPosition, r1, r2 });
+			result.push_back({ _frontPositions[i], r1, r2 });
 		}
 	}
 	return result;
 }
 
-const WeaponInfo& MissileManager::getWeaponInfo(const String& weaponName) { return _weaponInfo[weaponName]; }
+// Opis zwracany dla nieznanych nazw broni; nie jest dodawany do tablicy broni.
+const WeaponInfo& getNullWeaponInfo() {
+	static const WeaponInfo nullWeaponInfo = []() {
+		WeaponInfo weaponInfo = WeaponInfo();
+		weaponInfo.id = MissileManager::NULL_WEAPON_ID;
+		return weaponInfo;
+	}();
+	return nullWeaponInfo;
+}
+
+const WeaponInfo& MissileManager::getWeaponInfo(const String& weaponName) {
+	auto it = _weaponInfo.find(weaponName);
+	return it == _weaponInfo.end() ? getNullWeaponInfo() : it->second;
+}
+
+const WeaponInfo& MissileManager::getWeaponInfo(int weaponId) { return *_weaponsById[weaponId]; }
+
+int MissileManager::getWeaponId(const String& weaponName) {
+	auto it = _weaponInfo.find(weaponName);
+	return it == _weaponInfo.end() ? NULL_WEAPON_ID : it->second.id;
+}
 
 const std::map<String, WeaponInfo>& MissileManager::getWeaponsInfo() { return _weaponInfo; }
 
@@ -209,7 +299,7 @@ void MissileManager::initializeWeaponInfo() {
 		if (line.find_first_not_of(' ') != std::string::npos) {
 			std::istringstream iss(line);
 			if (!(iss >> name >> property) || lines.find(name) != lines.end()) {
-				Logger::log(Config.WeaponsDataFile + ": syntax error on line " + std::to_string(i) + ".");
+				LOG(LOG_ERROR, LOG_RESOURCES, Config.WeaponsDataFile + ": syntax error on line " + std::to_string(i) + ".");
 			}
 			else { lines[name] = property; }
 		}
@@ -230,5 +320,9 @@ void MissileManager::initializeWeaponInfo() {
 			_weaponInfo[weaponInfo.name] = weaponInfo;
 		}
 	}
-	
-}
+
+	for (auto& entry : _weaponInfo) {
+		entry.second.id = _weaponsById.size();
+		_weaponsById.push_back(&entry.second);
+	}
+}
\ No newline at end of file
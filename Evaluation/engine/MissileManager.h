@@ -5,12 +5,15 @@
 #include "entities/Missile.h"
 #include "entities/Weapon.h"
 #include "math/Math.h"
+#include "engine/WorkerPool.h"
 
 class GameMap;
 struct Ring;
 
 class MissileManager {
 public:
+	static const int NULL_WEAPON_ID;
+
 	MissileManager();
 	~MissileManager();
 
@@ -20,29 +23,74 @@ public:
 	std::vector<Missile> getMissiles() const;
 	std::vector<common::Ring> getExplosions(GameTime time) const;
 
+	// Dla nieznanej nazwy zwraca pusty opis o identyfikatorze NULL_WEAPON_ID.
 	static const WeaponInfo& getWeaponInfo(const String& weaponName);
+	static const WeaponInfo& getWeaponInfo(int weaponId);
+	// Zwraca NULL_WEAPON_ID, jeeli bro o podanej nazwie nie istnieje.
+	static int getWeaponId(const String& weaponName);
 	static const std::map<String, WeaponInfo>& getWeaponsInfo();
 
 private:
 	GameMap* _map;
 	static std::map<String, WeaponInfo> _weaponInfo;
+	static std::vector<const WeaponInfo*> _weaponsById;
 	static bool _weaponInfoInitialized;
 
 	void initializeWeaponInfo();
-	void invokeDamage(Missile& missile, const Vector2& point);
 
-	Missile* _missiles;
-	int _capacity;
-	int _count;
+	// Pociski przechowywane w ukadzie tablic. Pozycja pocisku na prostej lotu zaley wycznie od czasu,
+	// wic prdko i dugo s kopiowane z opisu broni w chwili strzau. Indeksy nieaktywnych pociskw
+	// trafiaj na list wolnych miejsc i s wykorzystywane ponownie.
+	std::vector<MissileOwner*> _owners;
+	std::vector<Vector2> _origins;
+	std::vector<Vector2> _directions;
+	std::vector<Vector2> _targets;
+	std::vector<int> _weaponIds;
+	std::vector<float> _speeds;
+	std::vector<float> _lengths;
+	std::vector<GameTime> _timesFired;
+	std::vector<GameTime> _timesHit;
+	std::vector<unsigned char> _isActive;
+	std::vector<unsigned char> _isTargetReached;
+	std::vector<Vector2> _frontPositions;
+	std::vector<Vector2> _backPositions;
+	// ciany s nieruchome, wic punkt trafienia w cian i jego odlego od punktu startu
+	// wyznaczane s raz, w chwili strzau (odlego nieskoczona, jeeli pocisk nie trafi w cian).
+	std::vector<float> _wallDistances;
+	std::vector<Vector2> _wallHitPoints;
+	std::vector<int> _freeIndices;
+
+	// Odlegoci przodu i tyu pociskw od punktu startu, wyznaczane na pocztku update.
+	std::vector<float> _frontDistances;
+	std::vector<float> _backDistances;
+
+	// Trafienia i wyganicia pociskw wykryte przez wtek podczas rwnolegego przesuwania pociskw.
+	// Obraenia i zwalnianie miejsc wykonywane s pniej w jednym wtku, w kolejnoci indeksw pociskw.
+	struct MissileHit {
+		int missileIndex;
+		Vector2 point;
+	};
+
+	struct MissileEvents {
+		std::vector<MissileHit> hits;
+		std::vector<int> expired;
+	};
+
+	WorkerPool _workers;
+	std::vector<MissileEvents> _events;
+	std::vector<MissileHit> _hits;
+	std::vector<int> _expired;
 
 	static const int DEFAULT_CAPACITY = 32;
-	static const int RESIZE_CAPACITY = 16;
+	static const size_t BATCH_SIZE = 32;
 
-	void initializeMissile(int missileIndex, MissileOwner* owner, const Vector2& position, const Vector2& target, GameTime time);
-	void missileHit(Missile& missile, const Vector2& point, GameTime time);
+	void initializeMissile(MissileOwner* owner, const Vector2& position, const Vector2& target, int weaponId, GameTime time);
+	// Przesuwa pocisk i zapisuje zdarzenia w events. Zmienia wycznie stan pocisku missileIndex.
+	void stepMissile(int missileIndex, GameTime time, MissileEvents& events);
+	void applyEvents();
+	void invokeDamage(int missileIndex, const Vector2& point);
+	void missileHit(int missileIndex, const Vector2& point, GameTime time, MissileEvents& events);
 	int getNextIndex();
 };
 
-Segment getMissileLine(const Missile& missile, const GameTime& time);
-
 const WeaponInfo& getWeaponInfo(const String& weaponName);
\ No newline at end of file
@@ -0,0 +1,223 @@
+#include "MovementSystem.h"
+#include "engine/CollisionResolver.h"
+#include "engine/Orca.h"
+#include "entities/Actor.h"
+#include <algorithm>
+
+const size_t MovementSystem::BATCH_SIZE = 16;
+
+MovementSystem::MovementSystem(const CollisionResolver* collisionResolver, size_t threadsCount)
+	: _collisionResolver(collisionResolver), _cellSize(1), _gridLeft(0), _gridTop(0), _cellsX(1), _cellsY(1),
+	_workers(threadsCount) {}
+
+void MovementSystem::update(const std::vector<Actor*>& actors, GameTime time) {
+	gather(actors, time);
+	size_t n = _movables.size();
+	if (n == 0) { return; }
+
+	buildGrid();
+	_workers.parallelFor(n, BATCH_SIZE, [this](size_t i, size_t) { steer(i); });
+	_workers.parallelFor(n, BATCH_SIZE, [this](size_t i, size_t) { resolveCollisions(i); });
+	scatter(time);
+}
+
+void MovementSystem::gather(const std::vector<Actor*>& actors, GameTime time) {
+	_candidates.clear();
+	for (Actor* actor : actors) {
+		if (!actor->isDead()) {
+			_candidates.push_back(actor);
+		}
+	}
+
+	// Wybr prdkoci preferowanej dotyczy wycznie stanu danego obiektu, wic moe przebiega rwnolegle.
+	size_t n = _candidates.size();
+	_isPrepared.assign(n, 0);
+	_workers.parallelFor(n, BATCH_SIZE, [this, time](size_t i, size_t) { _isPrepared[i] = _candidates[i]->prepareMovement(time); });
+
+	_movables.resize(n);
+	_positionsX.resize(n);
+	_positionsY.resize(n);
+	_velocitiesX.resize(n);
+	_velocitiesY.resize(n);
+	_preferredX.resize(n);
+	_preferredY.resize(n);
+	_radii.resize(n);
+	_maxSpeeds.resize(n);
+	_isMoving.resize(n);
+	_isSolid.resize(n);
+	_isAllowed.resize(n);
+	_newVelocitiesX.resize(n);
+	_newVelocitiesY.resize(n);
+	_objectCells.resize(n);
+	if (n == 0) { return; }
+
+	float maxRadius = 0;
+	float left = _candidates[0]->_position.x, right = left;
+	float top = _candidates[0]->_position.y, bottom = top;
+	for (Movable* movable : _candidates) {
+		Vector2 position = movable->_position;
+		left = common::min(left, position.x);
+		right = common::max(right, position.x);
+		top = common::min(top, position.y);
+		bottom = common::max(bottom, position.y);
+		maxRadius = common::max(maxRadius, movable->getRadius());
+	}
+
+	// Ssiedzi znajduj si w komrce obiektu lub w komrkach przylegych.
+	_cellSize = Config.ActorVOCheckRadius + 2 * maxRadius + common::EPSILON;
+	_gridLeft = left;
+	_gridTop = top;
+	_cellsX = (int)((right - left) / _cellSize) + 1;
+	_cellsY = (int)((bottom - top) / _cellSize) + 1;
+
+	// Sortowanie kubekowe obiektw wedug komrek.
+	_cellStarts.assign(_cellsX * _cellsY + 1, 0);
+	for (size_t i = 0; i < n; ++i) {
+		Vector2 position = _candidates[i]->_position;
+		int cell = (int)((position.y - top) / _cellSize) * _cellsX + (int)((position.x - left) / _cellSize);
+		_objectCells[i] = cell;
+		++_cellStarts[cell + 1];
+	}
+	for (size_t c = 1; c < _cellStarts.size(); ++c) {
+		_cellStarts[c] += _cellStarts[c - 1];
+	}
+
+	std::vector<int> next(_cellStarts.begin(), _cellStarts.end() - 1);
+	for (size_t i = 0; i < n; ++i) {
+		int k = next[_objectCells[i]]++;
+		Movable* movable = _candidates[i];
+		_movables[k] = movable;
+		_positionsX[k] = movable->_position.x;
+		_positionsY[k] = movable->_position.y;
+		_velocitiesX[k] = movable->_velocity.x;
+		_velocitiesY[k] = movable->_velocity.y;
+		_preferredX[k] = movable->_preferredVelocity.x;
+		_preferredY[k] = movable->_preferredVelocity.y;
+		_radii[k] = movable->getRadius();
+		_maxSpeeds[k] = movable->getMaxSpeed();
+		_isMoving[k] = _isPrepared[i];
+		_isSolid[k] = movable->isSolid();
+	}
+}
+
+void MovementSystem::buildGrid() {
+	size_t n = _movables.size();
+	for (size_t k = 0; k < n; ++k) {
+		_objectCells[k] = (int)((_positionsY[k] - _gridTop) / _cellSize) * _cellsX + (int)((_positionsX[k] - _gridLeft) / _cellSize);
+	}
+}
+
+template <typename Function> void MovementSystem::forEachNeighbor(size_t i, Function function) const {
+	int cell = _objectCells[i];
+	int cellX = cell % _cellsX, cellY = cell / _cellsX;
+	for (int y = std::max(cellY - 1, 0); y <= std::min(cellY + 1, _cellsY - 1); ++y) {
+		int from = _cellStarts[y * _cellsX + std::max(cellX - 1, 0)];
+		int to = _cellStarts[y * _cellsX + std::min(cellX + 1, _cellsX - 1) + 1];
+		for (int j = from; j < to; ++j) {
+			if ((size_t)j != i && _isSolid[j]) {
+				function(j);
+			}
+		}
+	}
+}
+
+// Ograniczenia ORCA wyznaczane przez wtek (bufor wielokrotnego uytku).
+thread_local std::vector<OrcaLine> batchedOrcaLines;
+
+void MovementSystem::steer(size_t i) {
+	if (!_isMoving[i]) {
+		_newVelocitiesX[i] = 0;
+		_newVelocitiesY[i] = 0;
+		return;
+	}
+
+	std::vector<OrcaLine>& lines = batchedOrcaLines;
+	lines.clear();
+
+	Vector2 position(_positionsX[i], _positionsY[i]);
+	Vector2 velocity(_velocitiesX[i], _velocitiesY[i]);
+	float radius = _radii[i];
+	float range = Config.ActorVOCheckRadius;
+
+	computeObstacleLines(_collisionResolver, position, radius + Config.MovementSafetyMargin, _maxSpeeds[i], lines);
+	size_t obstacleLines = lines.size();
+
+	forEachNeighbor(i, [&](int j) {
+		Vector2 relativePosition(_positionsX[j] - position.x, _positionsY[j] - position.y);
+		float combinedRadius = radius + _radii[j] + common::EPSILON;
+		if (relativePosition.lengthSquared() <= common::sqr(range + combinedRadius)) {
+			lines.push_back(computeOrcaLine(relativePosition, velocity, Vector2(_velocitiesX[j], _velocitiesY[j]),
+				combinedRadius, Config.OrcaTimeHorizon, _isMoving[j] ? 0.5f : 1.0f));
+		}
+	});
+
+	Vector2 result = solveOrcaProgram(lines, obstacleLines, _maxSpeeds[i], Vector2(_preferredX[i], _preferredY[i]));
+	_newVelocitiesX[i] = result.x;
+	_newVelocitiesY[i] = result.y;
+}
+
+// Ruch jest dopuszczalny, jeeli przemieszczany okrg nie zahacza o innego aktora (w pooeniu
+// z pocztku klatki) ani nie zblia si do cian bardziej ni o Config.MovementSafetyMargin.
+// Pooenia ssiadw po ich ruchu sprawdzane s dopiero w scatter.
+void MovementSystem::resolveCollisions(size_t i) {
+	if (!_isMoving[i]) {
+		_isAllowed[i] = false;
+		return;
+	}
+
+	Vector2 from(_positionsX[i], _positionsY[i]);
+	Vector2 to = from + Vector2(_newVelocitiesX[i], _newVelocitiesY[i]);
+	Segment movement(from, to);
+	float radius = _radii[i];
+	bool isAllowed = true;
+
+	forEachNeighbor(i, [&](int j) {
+		if (isAllowed && common::distance(Vector2(_positionsX[j], _positionsY[j]), movement) < radius + _radii[j]) {
+			isAllowed = false;
+		}
+	});
+
+	if (isAllowed && checkStaticMovementCollisions(_collisionResolver, movement,
+		radius + Config.MovementSafetyMargin + common::EPSILON)) {
+		isAllowed = false;
+	}
+	_isAllowed[i] = isAllowed;
+}
+
+// Wywoania zdarze kolizji i aktualizacja struktury kolizji nie s bezpieczne wielowtkowo.
+// Dwa obiekty mog niezalenie wej w to samo wolne miejsce, dlatego przed wykonaniem ruchu
+// jego punkt kocowy jest porwnywany z pooeniami ssiadw ustalonymi w tej klatce: po ruchu
+// dla ssiadw ju przetworzonych i pocztkowymi dla pozostaych (te zostay sprawdzone w resolveCollisions).
+void MovementSystem::scatter(GameTime time) {
+	size_t n = _movables.size();
+	for (size_t i = 0; i < n; ++i) {
+		Movable* movable = _movables[i];
+		if (!_isMoving[i]) {
+			movable->CollisionInvoker::invokeCollision(movable->findResponders(movable->_position), time);
+			continue;
+		}
+
+		movable->_velocity = Vector2(_newVelocitiesX[i], _newVelocitiesY[i]);
+		MovementCheckResult result;
+		result.allowed = _isAllowed[i] != 0;
+		if (result.allowed) {
+			Vector2 to = movable->_position + movable->_velocity;
+			forEachNeighbor(i, [&](int j) {
+				if (result.allowed && common::sqDist(Vector2(_positionsX[j], _positionsY[j]), to) < common::sqr(_radii[i] + _radii[j])) {
+					result.allowed = false;
+				}
+			});
+		}
+		if (result.allowed) {
+			result.responders = movable->findResponders(movable->_position + movable->_velocity);
+		}
+		movable->finishMovement(result, time);
+		_positionsX[i] = movable->_position.x;
+		_positionsY[i] = movable->_position.y;
+
+		CollisionResolver* collisionResolver = movable->getCollisionResolver();
+		if (collisionResolver != nullptr && movable->hasPositionChanged()) {
+			collisionResolver->update(movable);
+		}
+	}
+}
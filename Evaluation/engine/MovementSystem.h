@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+#include "main/Configuration.h"
+#include "math/Math.h"
+#include "engine/WorkerPool.h"
+
+class Actor;
+class Movable;
+class CollisionResolver;
+
+// Wsadowa aktualizacja ruchu wszystkich aktorw (Config.BatchedMovement). Pooenia, prdkoci i promienie
+// s kopiowane do cigych tablic uporzdkowanych wedug komrek siatki ssiedztwa, dziki czemu ssiedzi
+// obiektu zajmuj kilka spjnych przedziaw. Wybr prdkoci (ORCA) i wykrywanie kolizji wykonywane s
+// rwnolegle na migawce stanu z pocztku klatki, a wyniki s przepisywane do obiektw w jednym wtku,
+// ktry odrzuca ruchy koczce si w pooeniu zajtym ju w tej klatce przez ssiada.
+// Dziaa tylko przy wyczonej wielowtkowoci agentw, gdy wszystkie akcje s ju wykonane.
+class MovementSystem {
+public:
+	MovementSystem(const CollisionResolver* collisionResolver, size_t threadsCount);
+
+	void update(const std::vector<Actor*>& actors, GameTime time);
+
+private:
+	static const size_t BATCH_SIZE;
+
+	const CollisionResolver* _collisionResolver;
+
+	std::vector<Movable*> _candidates;
+	std::vector<unsigned char> _isPrepared;
+
+	std::vector<Movable*> _movables;
+	std::vector<float> _positionsX;
+	std::vector<float> _positionsY;
+	std::vector<float> _velocitiesX;
+	std::vector<float> _velocitiesY;
+	std::vector<float> _preferredX;
+	std::vector<float> _preferredY;
+	std::vector<float> _radii;
+	std::vector<float> _maxSpeeds;
+	std::vector<unsigned char> _isMoving;
+	std::vector<unsigned char> _isSolid;
+	std::vector<unsigned char> _isAllowed;
+	std::vector<float> _newVelocitiesX;
+	std::vector<float> _newVelocitiesY;
+
+	// Obiekty komrki c zajmuj w tablicach przedzia [_cellStarts[c], _cellStarts[c + 1]).
+	std::vector<int> _cellStarts;
+	std::vector<int> _objectCells;
+	float _cellSize;
+	float _gridLeft;
+	float _gridTop;
+	int _cellsX;
+	int _cellsY;
+
+	WorkerPool _workers;
+
+	void gather(const std::vector<Actor*>& actors, GameTime time);
+	void buildGrid();
+	void steer(size_t i);
+	void resolveCollisions(size_t i);
+	void scatter(GameTime time);
+
+	template <typename Function> void forEachNeighbor(size_t i, Function function) const;
+};
@@ -11,6 +11,11 @@
 #include "engine/CollisionResolver.h"
 #include "engine/VectorCollisionResolver.h"
 #include "engine/TreeCollisionResolver.h"
+#include "engine/IndexedHeap.h"
+#include "engine/ConnectionGenerator.h"
+#include "engine/CompiledMap.h"
+#include <atomic>
+#include <thread>
 
 float GameMap::getWidth() const { return _width; }
 float GameMap::getHeight() const { return _height; }
@@ -27,6 +32,8 @@ void GameMap::destroy(GameMap* map) {
 		delete wallPtr;
 	}
 	delete map->_collisionResolver;
+	delete map->_pathCache;
+	delete map->_hierarchy;
 	delete map;
 }
 
@@ -36,6 +43,10 @@ std::vector<Trigger*> GameMap::getTriggers() const { return _triggers; }
 
 std::vector<StaticEntity*> GameMap::getWalls() const { return _walls; }
 
+size_t GameMap::getPathCacheHits() const { return _pathCache->getHits(); }
+
+size_t GameMap::getPathCacheMisses() const { return _pathCache->getMisses(); }
+
 bool GameMap::raycastStatic(const Segment& ray, Vector2& result) const {
 	Vector2 rayOrigin = ray.from;
 	bool collisionFound = false;
@@ -60,6 +71,13 @@ bool GameMap::raycastStatic(const Segment& ray, Vector2& result) const {
 
 const int GameMap::NULL_IDX = -1;
 
+const int GameMap::NAVIGATION_VISIBILITY_RANGE = 1;
+
+const String GameMap::NEXT_HOP_FILE_EXTENSION = ".paths";
+const String GameMap::COMPILED_MAP_EXTENSION = ".bin";
+const unsigned int GameMap::NEXT_HOP_FILE_HEADER = 0x50484e45;
+const unsigned int GameMap::NEXT_HOP_FILE_VERSION = 1;
+
 GameMap::NavigationNode::NavigationNode(float x, float y, int index) : position(x, y), index(index) { }
 
 bool GameMap::place(Actor* actor) {
@@ -89,60 +107,958 @@ void GameMap::remove(Actor* actor) {
 	}
 }
 
+//std::vector<GameDynamicObject*> GameMap::checkCollision(const Vector2& point) { 
+//	return _collisionResolver->broadphaseDynamic(point);
+//}
+
+//std::vector<GameDynamicObject*> GameMap::checkCollision(const Aabb& area) const { 
+//	return _collisionResolver->broadphase(area);
+//}
+
+const CollisionResolver* GameMap::getCollisionResolver() const {
+	return _collisionResolver;
+}
+
+std::vector<DynamicEntity*> GameMap::checkCollision(const Vector2& point, float radius) {
+	return _collisionResolver->broadphaseDynamic(point, radius);
+}
+
+std::vector<DynamicEntity*> GameMap::checkCollision(const Segment& segment) {
+	return _collisionResolver->broadphaseDynamic(segment.from, segment.to);
+}
+
+std::vector<Destructible*> GameMap::checkCollisionDestructible(const Vector2& point, float radius) const {
+	return getDestructibleInArea(_collisionResolver, point, radius);
+}
+
+float GameMap::estimateDistance(int fromIdx, int toIdx) const {
+	return common::distance(_navigationMesh.at(fromIdx).position, _navigationMesh.at(toIdx).position);
+}
+
+float GameMap::estimatePathDistance(int fromIdx, int toIdx) const {
+	if (_pathDistances.empty()) { return estimateDistance(fromIdx, toIdx); }
+	return _pathDistances[fromIdx * _navigationMesh.size() + toIdx];
+}
+
+// Stan wza w biecym wyszukiwaniu. Rekord jest wany tylko wtedy, gdy jego pokolenie
+// jest rwne pokoleniu biecego zapytania, dziki czemu tablic nie trzeba czyci.
+struct AStarNodeRecord {
+	unsigned int generation;
+	int previous;
+	float costSoFar;
+};
+
+// Dane wyszukiwania A* wykorzystywane ponownie przez kolejne zapytania w obrbie wtku.
+struct AStarWorkspace {
+	std::vector<AStarNodeRecord> records;
+	IndexedHeap<float> open;
+	std::vector<int> path;
+	std::vector<Vector2> waypoints;
+	std::vector<std::pair<int, int>> blockedArcs;
+	unsigned int generation = 0;
+
+	void prepare(size_t nodesCount) {
+		if (records.size() < nodesCount) {
+			records.resize(nodesCount, AStarNodeRecord{ 0, -1, 0 });
+			open.reserve(nodesCount);
+		}
+		open.clear();
+		if (++generation == 0) {
+			for (AStarNodeRecord& record : records) {
+				record.generation = 0;
+			}
+			generation = 1;
+		}
+	}
+
+	AStarNodeRecord& visit(int index) {
+		AStarNodeRecord& record = records[index];
+		if (record.generation != generation) {
+			record.generation = generation;
+			record.previous = -1;
+			record.costSoFar = std::numeric_limits<float>::infinity();
+		}
+		return record;
+	}
+};
+
+// Kady wtek agenta posiada wasn przestrze robocz, wic zapytania nie wymagaj synchronizacji.
+thread_local AStarWorkspace aStarWorkspace;
+
+bool isInIgnoredArea(const Vector2& point, const std::vector<common::Circle>& ignoredAreas) {
+	for (const common::Circle& circle : ignoredAreas) {
+		if (circle.contains(point)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool isArcInIgnoredArea(const Segment& arc, const std::vector<common::Circle>& ignoredAreas) {
+	for (const common::Circle& circle : ignoredAreas) {
+		if (common::distance(circle.center, arc) <= circle.radius) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Kandydaci na najbliszy wze nawigacji (kopiec wzgldem kwadratu odlegoci), wsplni dla zapyta wtku.
+thread_local std::vector<std::pair<float, int>> closestNodeCandidates;
+
+bool fartherCandidate(const std::pair<float, int>& first, const std::pair<float, int>& second) {
+	return first.first > second.first;
+}
+
+int GameMap::getNavigationCellX(float x) const {
+	int i = (int)floorf(x / _navigationCellSize);
+	return i < 0 ? 0 : i >= _navigationCellsX ? _navigationCellsX - 1 : i;
+}
+
+int GameMap::getNavigationCellY(float y) const {
+	int j = (int)floorf(y / _navigationCellSize);
+	return j < 0 ? 0 : j >= _navigationCellsY ? _navigationCellsY - 1 : j;
+}
+
+const GameMap::NavigationCell& GameMap::getNavigationCell(int i, int j) const {
+	return _navigationCells[j * _navigationCellsX + i];
+}
+
+void GameMap::getBlockedArcs(const std::vector<common::Circle>& areas, std::vector<std::pair<int, int>>& arcs) const {
+	arcs.clear();
+	for (const common::Circle& area : areas) {
+		int minX = getNavigationCellX(area.center.x - area.radius), maxX = getNavigationCellX(area.center.x + area.radius);
+		int minY = getNavigationCellY(area.center.y - area.radius), maxY = getNavigationCellY(area.center.y + area.radius);
+		for (int j = minY; j <= maxY; ++j) {
+			for (int i = minX; i <= maxX; ++i) {
+				for (const auto& arc : getNavigationCell(i, j).arcs) {
+					if (common::distance(area.center, Segment(_navigationMesh[arc.first].position,
+						_navigationMesh[arc.second].position)) <= area.radius) {
+						arcs.push_back(arc);
+					}
+				}
+			}
+		}
+	}
+	// uk przecinajcy kilka komrek lub obszarw jest zapisywany jeden raz.
+	std::sort(arcs.begin(), arcs.end());
+	arcs.erase(std::unique(arcs.begin(), arcs.end()), arcs.end());
+}
+
 int GameMap::getClosestNavigationNode(const Vector2& point, const std::vector<common::Circle>& ignoredAreas) const {
 	if (_navigationMesh.size() == 0) { return NULL_IDX; }
 
-	int closest = NULL_IDX;
+	int cellX = getNavigationCellX(point.x);
+	int cellY = getNavigationCellY(point.y);
+	const std::vector<int>& visibleNodes = getNavigationCell(cellX, cellY).visibleNodes;
+	float infinity = std::numeric_limits<float>::infinity();
+
+	std::vector<std::pair<float, int>>& candidates = closestNodeCandidates;
+	candidates.clear();
+
+	auto addCandidates = [&](int i, int j) {
+		if (i < 0 || j < 0 || i >= _navigationCellsX || j >= _navigationCellsY) { return; }
+		for (int nodeIdx : getNavigationCell(i, j).nodes) {
+			const NavigationNode& node = _navigationMesh[nodeIdx];
+			if (node.index != NULL_IDX && !isInIgnoredArea(node.position, ignoredAreas)) {
+				candidates.push_back(std::make_pair((node.position - point).lengthSquared(), nodeIdx));
+				std::push_heap(candidates.begin(), candidates.end(), fartherCandidate);
+			}
+		}
+	};
+
+	int maxRing = std::max(std::max(cellX, _navigationCellsX - 1 - cellX), std::max(cellY, _navigationCellsY - 1 - cellY));
 	Vector2 tempVector;
-	float minDist = std::numeric_limits<float>::infinity();
 
-	for (NavigationNode node : _navigationMesh) {
-		bool isAllowed = true;
-		for (const common::Circle& circle : ignoredAreas) {
-			if (circle.contains(node.position)) {
-				isAllowed = false;
-				break;
+	// Przegldamy komrki piercieniami wok komrki zawierajcej punkt. Kandydaci s sprawdzani
+	// w kolejnoci rosncej odlegoci, o ile aden wze spoza przejrzanego obszaru nie moe by bliej.
+	for (int ring = 0; ring <= maxRing; ++ring) {
+		if (ring == 0) {
+			addCandidates(cellX, cellY);
+		}
+		else {
+			for (int i = cellX - ring; i <= cellX + ring; ++i) {
+				addCandidates(i, cellY - ring);
+				addCandidates(i, cellY + ring);
+			}
+			for (int j = cellY - ring + 1; j <= cellY + ring - 1; ++j) {
+				addCandidates(cellX - ring, j);
+				addCandidates(cellX + ring, j);
 			}
 		}
-		if (isAllowed) {
-			float dist = (node.position - point).lengthSquared();
-			if (node.index != NULL_IDX && dist < minDist
-				// Promie nie powoduje przecicia ze cian lub przecicie jest punktem nawigacji
-				&& (!raycastStatic(Segment(point, node.position), tempVector)
-					|| common::sqDist(tempVector, node.position) < common::EPSILON)) {
-				minDist = dist;
-				closest = node.index;
+
+		float bound = infinity;
+		if (cellX - ring > 0) { bound = common::min(bound, point.x - (cellX - ring) * _navigationCellSize); }
+		if (cellX + ring < _navigationCellsX - 1) { bound = common::min(bound, (cellX + ring + 1) * _navigationCellSize - point.x); }
+		if (cellY - ring > 0) { bound = common::min(bound, point.y - (cellY - ring) * _navigationCellSize); }
+		if (cellY + ring < _navigationCellsY - 1) { bound = common::min(bound, (cellY + ring + 1) * _navigationCellSize - point.y); }
+		bound = bound == infinity ? infinity : common::sqr(common::max(bound, 0));
+
+		while (!candidates.empty() && candidates.front().first <= bound) {
+			std::pop_heap(candidates.begin(), candidates.end(), fartherCandidate);
+			int nodeIdx = candidates.back().second;
+			candidates.pop_back();
+
+			const NavigationNode& node = _navigationMesh[nodeIdx];
+			// Wze jest widoczny z caej komrki, promie nie powoduje przecicia ze cian
+			// lub przecicie jest punktem nawigacji.
+			if (std::binary_search(visibleNodes.begin(), visibleNodes.end(), nodeIdx)
+				|| !raycastStatic(Segment(point, node.position), tempVector)
+				|| common::sqDist(tempVector, node.position) < common::EPSILON) {
+				return node.index;
 			}
 		}
 	}
 
-	return closest;
+	return NULL_IDX;
 }
 
-//std::vector<GameDynamicObject*> GameMap::checkCollision(const Vector2& point) { 
-//	return _collisionResolver->broadphaseDynamic(point);
-//}
+bool GameMap::aStar(int from, int to, const std::vector<common::Circle>& ignoredAreas, std::vector<int>& path) const {
+	AStarWorkspace& workspace = aStarWorkspace;
+	workspace.prepare(_navigationMesh.size());
+	IndexedHeap<float>& open = workspace.open;
+	path.clear();
 
-//std::vector<GameDynamicObject*> GameMap::checkCollision(const Aabb& area) const { 
-//	return _collisionResolver->broadphase(area);
-//}
+	workspace.visit(from).costSoFar = 0;
+	open.pushOrDecrease(from, estimatePathDistance(from, to));
 
-const CollisionResolver* GameMap::getCollisionResolver() const {
-	return _collisionResolver;
+	bool isPathFound = false;
+
+	while (!open.isEmpty()) {
+		int current = open.pop();
+		if (current == to) {
+			isPathFound = true;
+			break;
+		}
+
+		const NavigationNode& currentNode = _navigationMesh[current];
+
+		// Jeli wze znajduje si w ignorowanym obszarze, przechodzimy do nastpnego.
+		if (!ignoredAreas.empty() && isInIgnoredArea(currentNode.position, ignoredAreas)) { continue; }
+
+		float currentCost = workspace.records[current].costSoFar;
+
+		for (const NavigationNode::Arc& connection : currentNode.arcs) {
+			int nodeValue = connection.first;
+			float costSoFar = currentCost + connection.second;
+
+			AStarNodeRecord& record = workspace.visit(nodeValue);
+			if (record.costSoFar <= costSoFar) { continue; }
+
+			if (!ignoredAreas.empty() && isArcInIgnoredArea(
+				Segment(currentNode.position, _navigationMesh[nodeValue].position), ignoredAreas)) {
+				continue;
+			}
+
+			// Wze odwiedzony po raz pierwszy, lepsza droga do wza otwartego
+			// lub ponowne otwarcie wza zamknitego.
+			record.costSoFar = costSoFar;
+			record.previous = current;
+			open.pushOrDecrease(nodeValue, costSoFar + estimatePathDistance(nodeValue, to));
+		}
+	}
+
+	if (isPathFound) {
+		for (int node = to; node != NULL_IDX; node = workspace.records[node].previous) {
+			path.push_back(node);
+			if (node == from) { break; }
+		}
+	}
+
+	return isPathFound;
+}
+
+bool GameMap::hasNextHopTable() const { return !_nextHop.empty(); }
+
+bool GameMap::walkNextHopTable(int from, int to, std::vector<int>& path) const {
+	int n = _navigationMesh.size();
+	path.clear();
+	if (_nextHop[from * n + to] == NULL_IDX) { return false; }
+
+	// cieka jest zwracana w tej samej kolejnoci co w aStar (od celu do pocztku).
+	int current = from;
+	path.push_back(current);
+	while (current != to && (int)path.size() <= n) {
+		current = _nextHop[current * n + to];
+		path.push_back(current);
+	}
+	std::reverse(path.begin(), path.end());
+	return current == to;
+}
+
+Path GameMap::findPath(const Vector2& from, const Vector2& to, float radius) const {
+	return findPath(from, to, radius, {});
+}
+
+Path GameMap::findPath(const Vector2& from, const Vector2& to, 
+	float radius, const std::vector<common::Circle>& ignoredAreas) const {
+
+	int start = getClosestNavigationNode(from, ignoredAreas);
+	int end = isPositionValid(_collisionResolver, from, radius) ? getClosestNavigationNode(to, ignoredAreas) : -1;
+	if (start == -1 || end == -1) { return Path(); }
+	else {
+		std::vector<int>& pathIndices = aStarWorkspace.path;
+		std::vector<std::pair<int, int>>& blockedArcs = aStarWorkspace.blockedArcs;
+		getBlockedArcs(ignoredAreas, blockedArcs);
+		// Wyszukiwanie pomija wzy i uki lece w ignorowanych obszarach, a kady wze w obszarze
+		// jest kocem zablokowanego uku. Obszary, ktre nie blokuj adnego uku, nie zmieniaj wic wyniku.
+		if (blockedArcs.empty() && hasNextHopTable()) {
+			walkNextHopTable(start, end, pathIndices);
+		}
+		else if (!_pathCache->find(start, end, blockedArcs, pathIndices)) {
+			if (_hierarchy != nullptr) {
+				_hierarchy->findPath(start, end, ignoredAreas, pathIndices);
+			}
+			else {
+				aStar(start, end, ignoredAreas, pathIndices);
+			}
+			_pathCache->insert(start, end, blockedArcs, pathIndices);
+		}
+		Path result;
+		smoothPath(from, to, radius, pathIndices, result);
+		
+		return result;
+	}
+}
+
+void GameMap::smoothPath(const Vector2& from, const Vector2& to, float radius, const std::vector<int>& pathIndices, Path& result) const {
+	if (pathIndices.empty()) { return; }
+
+	std::vector<Vector2>& waypoints = aStarWorkspace.waypoints;
+	waypoints.clear();
+	for (auto it = pathIndices.rbegin(); it != pathIndices.rend(); ++it) {
+		waypoints.push_back(getNodePosition(*it));
+	}
+	waypoints.push_back(to);
+
+	float margin = radius + Config.MovementSafetyMargin + common::EPSILON;
+	size_t n = waypoints.size();
+	
+	// Z biecego punktu przechodzimy do najdalszego kolejnego punktu cieki, do ktrego prowadzi
+	// odcinek oddalony od cian o co najmniej promie obiektu powikszony o margines bezpieczestwa.
+	// Pierwszy niewidoczny punkt koczy poszukiwania, wic liczba testw jest liniowa wzgldem dugoci cieki.
+	Vector2 anchor = from;
+	float rawLength = 0, smoothedLength = 0;
+	size_t i = 0;
+	while (i < n) {
+		size_t j = i;
+		while (j + 1 < n && !checkStaticMovementCollisions(_collisionResolver, Segment(anchor, waypoints[j + 1]), margin)) {
+			++j;
+		}
+		smoothedLength += common::distance(anchor, waypoints[j]);
+		anchor = waypoints[j];
+		result.push(anchor);
+		i = j + 1;
+	}
+
+	Vector2 previous = from;
+	for (const Vector2& waypoint : waypoints) {
+		rawLength += common::distance(previous, waypoint);
+		previous = waypoint;
+	}
+
+	std::lock_guard<std::mutex> lock(_smoothingStatisticsMutex);
+	++_smoothingStatistics.paths;
+	_smoothingStatistics.rawWaypoints += n;
+	_smoothingStatistics.smoothedWaypoints += result.getSize();
+	_smoothingStatistics.rawLength += rawLength;
+	_smoothingStatistics.smoothedLength += smoothedLength;
+}
+
+Path GameMap::replan(IncrementalPlanner& planner, const Vector2& from, const Vector2& to,
+	float radius, const common::Circle& blockedArea) const {
+
+	int end = getClosestNavigationNode(to, {});
+	if (end == NULL_IDX) { return Path(); }
+
+	std::lock_guard<std::mutex> lock(planner.getMutex());
+	if (planner.getGoal() != end) {
+		planner.reset(end);
+	}
+
+	std::vector<common::Circle> blockedAreas = planner.getBlockedAreas();
+	blockedAreas.push_back(blockedArea);
+	int start = getClosestNavigationNode(from, blockedAreas);
+	if (start == NULL_IDX) { return Path(); }
+
+	std::vector<int>& pathIndices = aStarWorkspace.path;
+	Path result;
+	if (planner.findPath(start, { blockedArea }, pathIndices)) {
+		smoothPath(from, to, radius, pathIndices, result);
+	}
+	return result;
+}
+
+int GameMap::getClosestNavigationNode(const Vector2& point) const {
+	return getClosestNavigationNode(point, {});
+}
+
+std::shared_ptr<const FlowField> GameMap::computeFlowField(int target) const {
+	size_t n = _navigationMesh.size();
+	std::vector<int> nextNodes(n, FlowField::NULL_IDX);
+	std::vector<float> distances(n, std::numeric_limits<float>::infinity());
+	IndexedHeap<float> open;
+	open.reserve(n);
+
+	distances[target] = 0;
+	open.pushOrDecrease(target, 0);
+	while (!open.isEmpty()) {
+		int current = open.pop();
+		for (const NavigationNode::Arc& arc : _navigationMesh[current].reverseArcs) {
+			float distance = distances[current] + arc.second;
+			if (distance < distances[arc.first]) {
+				distances[arc.first] = distance;
+				nextNodes[arc.first] = current;
+				open.pushOrDecrease(arc.first, distance);
+			}
+		}
+	}
+
+	return std::make_shared<const FlowField>(target, std::move(nextNodes), std::move(distances));
+}
+
+Path GameMap::followFlowField(const FlowField& field, const Vector2& from, const Vector2& to, Movable* movable) const {
+	Path result;
+	int start = getClosestNavigationNode(from, {});
+	if (start != NULL_IDX && field.getPath(start, aStarWorkspace.path)) {
+		smoothPath(from, to, movable->getRadius(), aStarWorkspace.path, result);
+	}
+	return result;
+}
+
+GameMap::PathSmoothingStatistics GameMap::getPathSmoothingStatistics() const {
+	std::lock_guard<std::mutex> lock(_smoothingStatisticsMutex);
+	return _smoothingStatistics;
+}
+
+Vector2 GameMap::getNodePosition(int index) const { return _navigationMesh.at(index).position; }
+
+bool GameMap::canPlace(const DynamicEntity* object) const {
+	return isPositionValid(_collisionResolver, object);
+}
+
+void GameMap::initializeDynamic(const std::vector<DynamicEntity*>& dynamicObjects) {
+	_collisionResolver->initializeDynamic(dynamicObjects);
+	for (DynamicEntity* entity : dynamicObjects) {
+		// to do (entity nie musi by aktorem; ta funkcja powinna by prywatna)
+		_entities.push_back(dynamic_cast<Actor*>(entity));
+	}
+}
+
+GameMap* GameMap::Loader::load(const char* mapFilename) {
+	_map = new GameMap();
+	_map->_pathCache = new PathCache(Config.PathCacheSize);
+	_map->_hierarchy = nullptr;
+	_map->_collisionResolver = nullptr;
+
+	// Skompilowana wersja mapy jest uywana, o ile istnieje i jest poprawna.
+	std::vector<TriggerSpawn> triggers;
+	if (!loadCompiled(mapFilename + COMPILED_MAP_EXTENSION, mapFilename, triggers)) {
+		loadText(mapFilename, triggers);
+	}
+	
+	if (Config.CollisionResolver == "AabbTree") {
+		_map->_collisionResolver = new TreeCollisionResolver();
+	}
+	else if (Config.CollisionResolver == "RegularGrid") {
+		_map->_collisionResolver = new RegularGrid(_map->getWidth(), _map->getHeight(), Config.RegularGridSize);
+	}
+	else {
+		_map->_collisionResolver = new VectorCollisionResolver();
+	}
+
+	buildNavigationArcIndex();
+	buildReverseArcs();
+	prepareNextHopTable(mapFilename);
+	buildNavigationHierarchy();
+	
+	for (auto staticObj : _map->_walls) {
+		_map->_collisionResolver->add(staticObj);
+	}
+
+	for (auto dynamicObj : createTriggers(triggers)) {
+		if (!_map->place(dynamicObj)) {
+			delete dynamicObj;
+		}
+	}
+
+	return _map;
+}
+
+void GameMap::Loader::loadText(const String& mapFilename, std::vector<TriggerSpawn>& triggers) {
+	_reader.open(mapFilename);
+
+	if (_reader.fail()) {
+		throw "Plik '" + mapFilename + "' nie istnieje, jest niedostpny lub uszkodzony.";
+	}
+
+	loadMapSize();
+	loadNavigationPoints();
+	loadNavigationMesh();
+	_map->_walls = loadStaticObjects();
+	buildNavigationGrid();
+	triggers = loadTriggers();
+
+	_reader.close();
+}
+
+void GameMap::Loader::loadMapSize() {
+	std::string s;
+	_reader >> s >> _map->_width >> s >> _map->_height;
+}
+
+void GameMap::Loader::loadNavigationPoints() {
+	int points, idx;
+	float posX, posY;
+	std::string s;
+	_reader >> s >> points;
+
+	_map->_navigationMesh.reserve(points);
+
+	for (int i = 0; i < points; i++) {
+		_reader >> s >> idx >> s >> posX >> s >> posY;
+		_map->_navigationMesh.push_back(NavigationNode(posX, posY, idx));
+	}
+}
+
+void GameMap::Loader::loadNavigationMesh() {
+	int connections, fromIdx, toIdx;
+	float modifier;
+	bool inverse;
+	std::string s;
+	_reader >> s >> connections;
+
+	for (int i = 0; i < connections; i++) {
+		_reader >> s >> fromIdx >> s >> toIdx >> s >> modifier >> s >> inverse;
+		NavigationNode* from = &_map->_navigationMesh.at(fromIdx);
+		NavigationNode* to = &_map->_navigationMesh.at(toIdx);
+		float dist = common::distance(from->position, to->position) * common::abs(modifier);
+		from->arcs.push_back(NavigationNode::Arc(toIdx, dist));
+		if (inverse) {
+			to->arcs.push_back(NavigationNode::Arc(fromIdx, dist));
+		}
+	}
+}
+
+// Czy odcinek ma punkt wsplny z wieloktem wypukym o podanych wierzchokach.
+bool testSegmentAndConvexPolygon(const Segment& segment, const Vector2* vertices, size_t n) {
+	Vector2 temp;
+	for (size_t i = 0; i < n; ++i) {
+		if (common::testSegments(segment, Segment(vertices[i], vertices[(i + 1) % n]), temp)) {
+			return true;
+		}
+	}
+	// Odcinek nie przecina brzegu, wic ley w caoci wewntrz lub na zewntrz wielokta.
+	int orientation = 0;
+	for (size_t i = 0; i < n; ++i) {
+		int o = common::sign(common::cross(vertices[(i + 1) % n] - vertices[i], segment.from - vertices[i]));
+		if (o != 0) {
+			if (orientation != 0 && o != orientation) { return false; }
+			orientation = o;
+		}
+	}
+	return orientation != 0;
+}
+
+// Czy odcinek czcy dowolny punkt obszaru area z punktem point nie przecina adnej ze cian.
+// Otoczka wypuka prostokta i punktu jest sum prostokta i trjktw opartych na jego bokach.
+bool isVisibleFromArea(const Aabb& area, const Vector2& point, const std::vector<StaticEntity*>& walls) {
+	Vector2 corners[4] = { area.getTopLeft(), area.getTopRight(), area.getBottomRight(), area.getBottomLeft() };
+	Aabb hull = Aabb::merge(area, Aabb(point, point));
+
+	for (StaticEntity* wall : walls) {
+		if (!hull.intersects(wall->getAabb())) { continue; }
+		for (const Segment& seg : wall->getBounds()) {
+			if (testSegmentAndConvexPolygon(seg, corners, 4)) { return false; }
+			for (size_t i = 0; i < 4; ++i) {
+				Vector2 triangle[3] = { point, corners[i], corners[(i + 1) % 4] };
+				if (testSegmentAndConvexPolygon(seg, triangle, 3)) { return false; }
+			}
+		}
+	}
+	return true;
+}
+
+void GameMap::Loader::buildNavigationGrid() {
+	float cellSize = Config.RegularGridSize;
+	int cellsX = common::max(1, ceilf(_map->_width / cellSize));
+	int cellsY = common::max(1, ceilf(_map->_height / cellSize));
+
+	_map->_navigationCellSize = cellSize;
+	_map->_navigationCellsX = cellsX;
+	_map->_navigationCellsY = cellsY;
+	_map->_navigationCells = std::vector<NavigationCell>(cellsX * cellsY);
+
+	int n = _map->_navigationMesh.size();
+	for (int i = 0; i < n; ++i) {
+		Vector2 position = _map->_navigationMesh[i].position;
+		int cellX = _map->getNavigationCellX(position.x);
+		int cellY = _map->getNavigationCellY(position.y);
+		_map->_navigationCells[cellY * cellsX + cellX].nodes.push_back(i);
+	}
+
+	// Dla kadej komrki zapamitujemy pobliskie wzy widoczne z kadego jej punktu.
+	// Dla nich wyszukiwanie najbliszego wza nie wymaga rzucania promienia.
+	int range = NAVIGATION_VISIBILITY_RANGE;
+	for (int cellY = 0; cellY < cellsY; ++cellY) {
+		for (int cellX = 0; cellX < cellsX; ++cellX) {
+			Aabb area(cellX * cellSize, cellY * cellSize, cellSize, cellSize);
+			std::vector<int>& visibleNodes = _map->_navigationCells[cellY * cellsX + cellX].visibleNodes;
+
+			for (int j = common::max(0, cellY - range); j <= common::min(cellsY - 1, cellY + range); ++j) {
+				for (int i = common::max(0, cellX - range); i <= common::min(cellsX - 1, cellX + range); ++i) {
+					for (int nodeIdx : _map->_navigationCells[j * cellsX + i].nodes) {
+						if (isVisibleFromArea(area, _map->_navigationMesh[nodeIdx].position, _map->_walls)) {
+							visibleNodes.push_back(nodeIdx);
+						}
+					}
+				}
+			}
+			std::sort(visibleNodes.begin(), visibleNodes.end());
+		}
+	}
+}
+
+// uki nie s zapisywane w skompilowanej mapie, poniewa wyznaczenie ich komrek jest szybkie.
+void GameMap::Loader::buildNavigationArcIndex() {
+	auto& mesh = _map->_navigationMesh;
+	std::vector<std::pair<int, int>> arcs;
+	for (size_t i = 0; i < mesh.size(); ++i) {
+		for (const NavigationNode::Arc& arc : mesh[i].arcs) {
+			arcs.push_back(std::make_pair(std::min((int)i, arc.first), std::max((int)i, arc.first)));
+		}
+	}
+	std::sort(arcs.begin(), arcs.end());
+	arcs.erase(std::unique(arcs.begin(), arcs.end()), arcs.end());
+
+	// uk trafia do komrek, ktrych okrg opisany ma z nim punkt wsplny.
+	float cellSize = _map->_navigationCellSize;
+	float cellRadius = cellSize * sqrtf(2.0f) / 2;
+	for (const auto& arc : arcs) {
+		Segment segment(mesh[arc.first].position, mesh[arc.second].position);
+		int minX = _map->getNavigationCellX(common::min(segment.from.x, segment.to.x));
+		int maxX = _map->getNavigationCellX(common::max(segment.from.x, segment.to.x));
+		int minY = _map->getNavigationCellY(common::min(segment.from.y, segment.to.y));
+		int maxY = _map->getNavigationCellY(common::max(segment.from.y, segment.to.y));
+		for (int j = minY; j <= maxY; ++j) {
+			for (int i = minX; i <= maxX; ++i) {
+				Vector2 center((i + 0.5f) * cellSize, (j + 0.5f) * cellSize);
+				if (common::distance(center, segment) <= cellRadius) {
+					_map->_navigationCells[j * _map->_navigationCellsX + i].arcs.push_back(arc);
+				}
+			}
+		}
+	}
+}
+
+void GameMap::Loader::buildReverseArcs() {
+	auto& mesh = _map->_navigationMesh;
+	for (size_t i = 0; i < mesh.size(); ++i) {
+		for (const NavigationNode::Arc& arc : mesh[i].arcs) {
+			mesh[arc.first].reverseArcs.push_back(NavigationNode::Arc(i, arc.second));
+		}
+	}
+}
+
+void GameMap::Loader::buildNavigationHierarchy() {
+	int n = _map->_navigationMesh.size();
+	if (Config.HierarchicalPathfindingMinNodes <= 0 || n < Config.HierarchicalPathfindingMinNodes) { return; }
+
+	std::vector<Vector2> positions;
+	std::vector<std::vector<NavigationNode::Arc>> arcs;
+	positions.reserve(n);
+	arcs.reserve(n);
+	for (const NavigationNode& node : _map->_navigationMesh) {
+		positions.push_back(node.position);
+		arcs.push_back(node.arcs);
+	}
+
+	_map->_hierarchy = new HierarchicalGraph(positions, arcs,
+		_map->_width, _map->_height, Config.HierarchicalClusterSize);
+}
+
+// Suma kontrolna grafu nawigacji (FNV-1a), pozwalajca wykry nieaktualny plik z tablic cieek.
+unsigned long long GameMap::Loader::computeNavigationChecksum() const {
+	uint64_t hash = computeChecksum(nullptr, 0);
+	for (const NavigationNode& node : _map->_navigationMesh) {
+		hash = computeChecksum(&node.position.x, sizeof(float), hash);
+		hash = computeChecksum(&node.position.y, sizeof(float), hash);
+		for (const NavigationNode::Arc& arc : node.arcs) {
+			hash = computeChecksum(&arc.first, sizeof(int), hash);
+			hash = computeChecksum(&arc.second, sizeof(float), hash);
+		}
+	}
+	return hash;
+}
+
+// Dijkstra z kadego wza. Dla wza startowego s wiersz tablicy zawiera pierwszy krok
+// najkrtszej cieki z s do kadego z pozostaych wzw. Wiersze s wyznaczane rwnolegle.
+void GameMap::Loader::buildNextHopTable() {
+	int n = _map->_navigationMesh.size();
+	const std::vector<NavigationNode>& mesh = _map->_navigationMesh;
+	std::vector<int>& nextHop = _map->_nextHop;
+	std::vector<float>& distances = _map->_pathDistances;
+	float infinity = std::numeric_limits<float>::infinity();
+
+	nextHop.assign(n * n, NULL_IDX);
+	distances.assign(n * n, infinity);
+
+	std::atomic<int> nextSource(0);
+	auto worker = [&]() {
+		IndexedHeap<float> open;
+		open.reserve(n);
+		int source;
+		while ((source = nextSource++) < n) {
+			int* hops = &nextHop[source * n];
+			float* dist = &distances[source * n];
+
+			dist[source] = 0;
+			hops[source] = source;
+			open.pushOrDecrease(source, 0);
+
+			while (!open.isEmpty()) {
+				float currentCost = open.topKey();
+				int current = open.pop();
+				for (const NavigationNode::Arc& arc : mesh[current].arcs) {
+					float cost = currentCost + arc.second;
+					if (cost < dist[arc.first]) {
+						dist[arc.first] = cost;
+						hops[arc.first] = current == source ? arc.first : hops[current];
+						open.pushOrDecrease(arc.first, cost);
+					}
+				}
+			}
+		}
+	};
+
+	int threadsCount = common::max(1, (int)std::thread::hardware_concurrency());
+	std::vector<std::thread> threads;
+	for (int i = 1; i < threadsCount; ++i) {
+		threads.push_back(std::thread(worker));
+	}
+	worker();
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
+
+bool GameMap::Loader::loadNextHopTable(const String& filename, unsigned long long checksum) {
+	std::ifstream reader(filename, std::ios::binary);
+	if (reader.fail()) { return false; }
+
+	unsigned int header, version;
+	int n = _map->_navigationMesh.size(), nodes;
+	unsigned long long fileChecksum;
+	reader.read(reinterpret_cast<char*>(&header), sizeof(header));
+	reader.read(reinterpret_cast<char*>(&version), sizeof(version));
+	reader.read(reinterpret_cast<char*>(&nodes), sizeof(nodes));
+	reader.read(reinterpret_cast<char*>(&fileChecksum), sizeof(fileChecksum));
+	if (reader.fail() || header != NEXT_HOP_FILE_HEADER || version != NEXT_HOP_FILE_VERSION
+		|| nodes != n || fileChecksum != checksum) {
+		return false;
+	}
+
+	_map->_nextHop.resize(n * n);
+	_map->_pathDistances.resize(n * n);
+	reader.read(reinterpret_cast<char*>(_map->_nextHop.data()), n * n * sizeof(int));
+	reader.read(reinterpret_cast<char*>(_map->_pathDistances.data()), n * n * sizeof(float));
+	if (reader.fail()) {
+		_map->_nextHop.clear();
+		_map->_pathDistances.clear();
+		return false;
+	}
+	return true;
+}
+
+void GameMap::Loader::saveNextHopTable(const String& filename, unsigned long long checksum) {
+	std::ofstream writer(filename, std::ios::binary | std::ios::trunc);
+	// Brak moliwoci zapisu nie jest bdem, tablica zostanie wyznaczona ponownie przy nastpnym wczytaniu.
+	if (writer.fail()) { return; }
+
+	int n = _map->_navigationMesh.size();
+	writer.write(reinterpret_cast<const char*>(&NEXT_HOP_FILE_HEADER), sizeof(NEXT_HOP_FILE_HEADER));
+	writer.write(reinterpret_cast<const char*>(&NEXT_HOP_FILE_VERSION), sizeof(NEXT_HOP_FILE_VERSION));
+	writer.write(reinterpret_cast<const char*>(&n), sizeof(n));
+	writer.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+	writer.write(reinterpret_cast<const char*>(_map->_nextHop.data()), n * n * sizeof(int));
+	writer.write(reinterpret_cast<const char*>(_map->_pathDistances.data()), n * n * sizeof(float));
+}
+
+void GameMap::Loader::prepareNextHopTable(const String& mapFilename) {
+	int n = _map->_navigationMesh.size();
+	// Powyej limitu tablica (n^2 elementw) zajmowaaby zbyt duo pamici, uywane jest wtedy A*.
+	if (n == 0 || n > Config.NextHopTableMaxNodes) { return; }
+
+	String filename = mapFilename + NEXT_HOP_FILE_EXTENSION;
+	unsigned long long checksum = computeNavigationChecksum();
+	if (!loadNextHopTable(filename, checksum)) {
+		buildNextHopTable();
+		saveNextHopTable(filename, checksum);
+	}
+}
+
+std::vector<StaticEntity*> GameMap::Loader::loadStaticObjects() {
+	size_t staticObjectsSize;
+	float x1, y1, x2, y2, id, p;
+	std::string objectType, s;
+	std::vector<StaticEntity*> staticObjects;
+	_reader >> s >> staticObjectsSize;
+	staticObjects.reserve(staticObjectsSize);
+
+	for (size_t i = 0; i < staticObjectsSize; i++) {
+		_reader >> objectType;
+		if (objectType == "wall:") {
+			_reader >> x1 >> y1 >> x2 >> y2 >> s >> id >> s >> p;
+			staticObjects.push_back(new Wall(id, Vector2(x1, y1), Vector2(x2, y2), p));
+		}
+		else {
+			throw "Nieprawidowa struktura pliku mapy! Nie rozpoznano: '" + objectType + "'.";
+		}
+	}
+
+	return staticObjects;
+}
+
+std::vector<GameMap::Loader::TriggerSpawn> GameMap::Loader::loadTriggers() {
+	size_t dynamicObjectsSize;
+	float x, y;
+	std::string objectType, s;
+	std::vector<TriggerSpawn> triggers;
+	_reader >> s >> dynamicObjectsSize;
+	triggers.reserve(dynamicObjectsSize);
+
+	for (size_t i = 0; i < dynamicObjectsSize; ++i) {
+		_reader >> objectType >> x >> y;
+		triggers.push_back({ objectType, Vector2(x, y) });
+	}
+
+	return triggers;
 }
 
-std::vector<DynamicEntity*> GameMap::checkCollision(const Vector2& point, float radius) {
-	return _collisionResolver->broadphaseDynamic(point, radius);
-}
+std::vector<Trigger*> GameMap::Loader::createTriggers(const std::vector<TriggerSpawn>& triggers) {
+	std::vector<Trigger*> dynamicObjects;
+	dynamicObjects.reserve(triggers.size());
+
+	for (const TriggerSpawn& trigger : triggers) {
+		if (trigger.type == Config.MedPackName) {
+			dynamicObjects.push_back(TriggerFactory::create(TriggerType::HEALTH, trigger.position));
+		}
+		else if (trigger.type == Config.ArmorPackName) {
+			dynamicObjects.push_back(TriggerFactory::create(TriggerType::ARMOR, trigger.position));
+		}
+		else {
+			dynamicObjects.push_back(TriggerFactory::create(trigger.type, trigger.position));
+		}
+	}
+
+	return dynamicObjects;
+}
+
+void GameMap::Loader::generateConnections(const String& inputFile, const String& outputFile) {
+
+	_reader.open(inputFile);
+
+	if (_reader.fail()) {
+		throw "Plik '" + String(inputFile) + "' nie istnieje, jest niedostpny lub uszkodzony.";
+	}
+
+	int width, height, size;
+	std::vector<NavigationNode> points;
+	std::vector<Wall> walls;
+
+	float epsilon = common::EPSILON;
+
+	String s;
+	_reader >> s >> width >> s >> height;
+
+	int idx;
+	float posX, posY;
+	_reader >> s >> size;
+
+	points.reserve(size);
+
+	for (int i = 0; i < size; i++) {
+		_reader >> s >> idx >> s >> posX >> s >> posY;
+		points.push_back(NavigationNode(posX, posY, idx));
+	}
+
+	float x1, y1, x2, y2, id, p;
+	String objectType;
+	
+	_reader >> s >> size;
+	walls.reserve(size);
+
+	for (int i = 0; i < size; i++) {
+		_reader >> objectType;
+		if (objectType == "wall:") {
+			_reader >> x1 >> y1 >> x2 >> y2 >> s >> id >> s >> p;
+			Vector2 from(x1, y1), to(x2, y2);
+			if (common::sqDist(from, to) > epsilon) {
+				walls.push_back(Wall(id, Vector2(x1, y1), Vector2(x2, y2), p));
+			}
+		}
+		else {
+			throw "Nieprawidowa struktura pliku mapy! Nie rozpoznano: '" + objectType + "'.";
+		}
+	}
+
+	_reader.close();
+	
+	int n = points.size();
+	std::vector<Vector2> positions;
+	std::vector<Segment> wallSegments;
+	positions.reserve(n);
+	wallSegments.reserve(walls.size());
+	for (const NavigationNode& node : points) {
+		positions.push_back(node.position);
+	}
+	for (const Wall& wall : walls) {
+		wallSegments.push_back(wall.getSegment());
+	}
+
+	// Poczenie jest odrzucane, jeeli przechodzi zbyt blisko ciany lub przez inny punkt nawigacji.
+	GameTime from = SDL_GetPerformanceCounter();
+	ConnectionGenerator generator(positions, wallSegments, width, height, Config.ActorRadius);
+	auto connections = generator.generate(common::max(1, (int)std::thread::hardware_concurrency()),
+		[&points](int i, int j) { return points[i].index < points[j].index; });
+	GameTime time = SDL_GetPerformanceCounter() - from;
+
+	std::ofstream myfile;
+	myfile.open(outputFile);
+
+	myfile << "width: " << width << " height: " << height << "\n\n";
+
+	myfile << "navigation_points: " << n << "\n";
+	for (int i = 0; i < n; ++i) {
+		myfile << "id: " << points[i].index
+			<< " x: " << points[i].position.x
+			<< " y: " << points[i].position.y << "\n";
+	}
+
+	myfile << "\nconnections: " << connections.size() << "\n";
+	for (const auto& connection : connections) {
+		myfile << "from: " << points[connection.first].index
+			<< " to: " << points[connection.second].index << " mul: 1.0 inv: 1\n";
+	}
+
+	myfile << "\n";
+	for (const Wall& wall : walls) {
+		Segment s = wall.getSegment();
+		myfile << "wall: " << s.from.x << " " << s.from.y << " "
+			<< s.to.x << " " << s.to.y << " id: "
+			<< wall.getId() << " priority: " << wall.getPriority() << "\n";
+	}
+
+	myfile.close();
 
-std::vector<DynamicEntity*> GameMap::checkCollision(const Segment& segment) {
-	return _collisionResolver->broadphaseDynamic(segment.from, segment.to);
+	std::cout << "Generated " << connections.size() << " connections between " << n << " points in "
+		<< time * 1000 / SDL_GetPerformanceFrequency() << " ms.\n";
 }
 
-std::vector<Destructible*> GameMap::checkCollisionDestructible(const Vector2& point, float radius) const {
-	return getDestructibleInArea(_collisionResolver, point, radius);
-}
+#ifdef _DEBUG
 
+// Pierwotna implementacja A* (liniowe przeszukiwanie zbiorw otwartego i zamknitego),
+// zachowana jako punkt odniesienia dla benchmarkPathfinding.
 struct AStarNodeInfo {
 	int nodeValue;
 	int previous;
@@ -154,10 +1070,6 @@ bool lowerCost2(const AStarNodeInfo& first, const AStarNodeInfo& second) {
 	return first.estimatedTotalCost > second.estimatedTotalCost;
 }
 
-float GameMap::estimateDistance(int fromIdx, int toIdx) const {
-	return common::distance(_navigationMesh.at(fromIdx).position, _navigationMesh.at(toIdx).position);
-}
-
 typedef std::vector<AStarNodeInfo> AStarCollection;
 
 AStarCollection::iterator findNode(AStarCollection& collection, int value) {
@@ -206,7 +1118,7 @@ void removeNode(AStarCollection& collection, int value) {
 	}
 }
 
-std::vector<int> GameMap::aStar(int from, int to, const std::vector<common::Circle>& ignoredAreas) const {
+std::vector<int> GameMap::aStarReference(int from, int to, const std::vector<common::Circle>& ignoredAreas) const {
 
 	std::map<int, bool> allowedNodes;
 
@@ -307,361 +1219,364 @@ std::vector<int> GameMap::aStar(int from, int to, const std::vector<common::Circ
 	return path;
 }
 
-std::queue<Vector2> GameMap::findPath(const Vector2& from, const Vector2& to, Movable* movable) const {
-	return findPath(from, to, movable, {});
-}
-
-bool isMovementValid(CollisionResolver* collisionResolver, Movable* movable, const Vector2& movementVector) {
-	//float padding = movable->getRadius() + Config.MovementSafetyMargin + common::EPSILON;
-	Vector2 pos = movable->getPosition();
-	Segment segment = Segment(pos, pos + movementVector);
-	return !checkMovementCollisions(collisionResolver, movable, segment);
+Vector2 GameMap::getClosest(const Vector2& point) const {
+	int idx = getClosestNavigationNode(point, {});
+	return idx != NULL_IDX ? _navigationMesh[idx].position : Vector2();
 }
 
-std::queue<Vector2> GameMap::findPath(const Vector2& from, const Vector2& to, 
-	Movable* movable, const std::vector<common::Circle>& ignoredAreas) const {
-
-	int start = getClosestNavigationNode(from, ignoredAreas);
-	int end = isPositionValid(_collisionResolver, movable, true) ? getClosestNavigationNode(to, ignoredAreas) : -1;
-	if (start == -1 || end == -1) { return std::queue<Vector2>(); }
-	else {
-		std::vector<int> pathIndices = aStar(start, end, ignoredAreas);
-		std::queue<Vector2> result;
-		unsigned int size = pathIndices.size();
-
-		if (size > 0) {
-
-			//int first = 0;
-			//int last = size - 1;
-
-			//bool keepLooping = true;
-			//while (first < last && keepLooping) {
-			//	bool condition1 = isMovementValid(Segment(to, getNodePosition(pathIndices.at(first + 1))));
-			//	bool condition2 = false;
-			//	if (condition1) { ++first; }
-			//	if (first < last) {
-			//		condition2 = isMovementValid(Segment(from, getNodePosition(pathIndices.at(last - 1))));
-			//		if (condition2) { --last; }
-			//	}
-			//	keepLooping = condition1 || condition2;
-			//}
-
-			//if (first == last) {
-			//	if (!isMovementValid(Segment(from, to))) {
-			//		result.push(getNodePosition(pathIndices.at(first)));
-			//	}
-			//}
-			//else {
-			//	for (int i = last; i >= first; --i) {
-			//		result.push(getNodePosition(pathIndices.at(i)));
-			//	}
-			//}
-
-			if (!isMovementValid(_collisionResolver, movable, to - from)) {
-				int first = size - 1;
-				if (size > 1 && isMovementValid(_collisionResolver, movable, getNodePosition(pathIndices.at(size - 2)) - movable->getPosition())) {
-					--first;
-				}
-				for (int i = first; i >= 0; --i) {
-					result.push(getNodePosition(pathIndices.at(i)));
-				}
+float GameMap::getPathCost(const std::vector<int>& path) const {
+	float cost = 0;
+	for (size_t i = 1; i < path.size(); ++i) {
+		for (const NavigationNode::Arc& arc : _navigationMesh.at(path[i]).arcs) {
+			if (arc.first == path[i - 1]) {
+				cost += arc.second;
+				break;
 			}
-			result.push(to);
 		}
-		
-		return result;
-	}
-}
-
-Vector2 GameMap::getNodePosition(int index) const { return _navigationMesh.at(index).position; }
-
-bool GameMap::canPlace(const DynamicEntity* object) const {
-	return isPositionValid(_collisionResolver, object);
-}
-
-void GameMap::initializeDynamic(const std::vector<DynamicEntity*>& dynamicObjects) {
-	_collisionResolver->initializeDynamic(dynamicObjects);
-	for (DynamicEntity* entity : dynamicObjects) {
-		// to do (entity nie musi by aktorem; ta funkcja powinna by prywatna)
-		_entities.push_back(dynamic_cast<Actor*>(entity));
 	}
+	return cost;
 }
 
-GameMap* GameMap::Loader::load(const char* mapFilename) {
-	_reader.open(mapFilename);
-
-	if (_reader.fail()) {
-		throw "Plik '" + String(mapFilename) + "' nie istnieje, jest niedostpny lub uszkodzony.";
-	}
-
-	_map = new GameMap();
+void GameMap::benchmarkPathfinding(size_t queries) const {
+	int n = _navigationMesh.size();
+	if (n == 0) { return; }
 
-	loadMapSize();
-	
-	if (Config.CollisionResolver == "AabbTree") {
-		_map->_collisionResolver = new TreeCollisionResolver();
-	}
-	else if (Config.CollisionResolver == "RegularGrid") {
-		_map->_collisionResolver = new RegularGrid(_map->getWidth(), _map->getHeight(), Config.RegularGridSize);
-	}
-	else {
-		_map->_collisionResolver = new VectorCollisionResolver();
+	std::vector<std::pair<int, int>> pairs;
+	pairs.reserve(queries);
+	for (size_t i = 0; i < queries; ++i) {
+		pairs.push_back(std::make_pair(Rng::getInteger(0, n - 1), Rng::getInteger(0, n - 1)));
 	}
 
-	loadNavigationPoints();
-	loadNavigationMesh();
-	_map->_walls = loadStaticObjects();
-	
-	for (auto staticObj : _map->_walls) {
-		_map->_collisionResolver->add(staticObj);
-	}
+	GameTime frequency = SDL_GetPerformanceFrequency();
+	GameTime from, referenceTime, time;
+	std::vector<int> path;
+	size_t mismatches = 0;
 
-	for (auto dynamicObj : loadTriggers()) {
-		if (!_map->place(dynamicObj)) {
-			delete dynamicObj;
-		}
+	from = SDL_GetPerformanceCounter();
+	for (const auto& query : pairs) {
+		aStarReference(query.first, query.second, {});
 	}
+	referenceTime = SDL_GetPerformanceCounter() - from;
 
-	_reader.close();
-
-	return _map;
-}
-
-void GameMap::Loader::loadMapSize() {
-	std::string s;
-	_reader >> s >> _map->_width >> s >> _map->_height;
-}
-
-void GameMap::Loader::loadNavigationPoints() {
-	int points, idx;
-	float posX, posY;
-	std::string s;
-	_reader >> s >> points;
-
-	_map->_navigationMesh.reserve(points);
-
-	for (int i = 0; i < points; i++) {
-		_reader >> s >> idx >> s >> posX >> s >> posY;
-		_map->_navigationMesh.push_back(NavigationNode(posX, posY, idx));
+	from = SDL_GetPerformanceCounter();
+	for (const auto& query : pairs) {
+		aStar(query.first, query.second, {}, path);
 	}
-}
-
-void GameMap::Loader::loadNavigationMesh() {
-	int connections, fromIdx, toIdx;
-	float modifier;
-	bool inverse;
-	std::string s;
-	_reader >> s >> connections;
+	time = SDL_GetPerformanceCounter() - from;
 
-	for (int i = 0; i < connections; i++) {
-		_reader >> s >> fromIdx >> s >> toIdx >> s >> modifier >> s >> inverse;
-		NavigationNode* from = &_map->_navigationMesh.at(fromIdx);
-		NavigationNode* to = &_map->_navigationMesh.at(toIdx);
-		float dist = common::distance(from->position, to->position) * common::abs(modifier);
-		from->arcs.push_back(NavigationNode::Arc(toIdx, dist));
-		if (inverse) {
-			to->arcs.push_back(NavigationNode::Arc(fromIdx, dist));
+	// Obie implementacje musz znajdowa cieki o tym samym koszcie.
+	for (const auto& query : pairs) {
+		aStar(query.first, query.second, {}, path);
+		if (common::abs(getPathCost(path) - getPathCost(aStarReference(query.first, query.second, {}))) > 0.01f) {
+			++mismatches;
 		}
 	}
-}
 
-std::vector<StaticEntity*> GameMap::Loader::loadStaticObjects() {
-	size_t staticObjectsSize;
-	float x1, y1, x2, y2, id, p;
-	std::string objectType, s;
-	std::vector<StaticEntity*> staticObjects;
-	_reader >> s >> staticObjectsSize;
-	staticObjects.reserve(staticObjectsSize);
+	std::cout << "A* benchmark (" << n << " nodes, " << queries << " queries):\n"
+		<< "  reference: " << referenceTime * 1000000 / frequency << " us\n"
+		<< "  indexed heap: " << time * 1000000 / frequency << " us\n"
+		<< "  mismatched paths: " << mismatches << "\n";
 
-	for (size_t i = 0; i < staticObjectsSize; i++) {
-		_reader >> objectType;
-		if (objectType == "wall:") {
-			_reader >> x1 >> y1 >> x2 >> y2 >> s >> id >> s >> p;
-			staticObjects.push_back(new Wall(id, Vector2(x1, y1), Vector2(x2, y2), p));
+	if (hasNextHopTable()) {
+		mismatches = 0;
+		from = SDL_GetPerformanceCounter();
+		for (const auto& query : pairs) {
+			walkNextHopTable(query.first, query.second, path);
 		}
-		else {
-			throw "Nieprawidowa struktura pliku mapy! Nie rozpoznano: '" + objectType + "'.";
+		time = SDL_GetPerformanceCounter() - from;
+
+		for (const auto& query : pairs) {
+			walkNextHopTable(query.first, query.second, path);
+			float tableCost = getPathCost(path);
+			aStar(query.first, query.second, {}, path);
+			if (common::abs(tableCost - getPathCost(path)) > 0.01f) {
+				++mismatches;
+			}
 		}
-	}
 
-	return staticObjects;
+		std::cout << "  next-hop table: " << time * 1000000 / frequency << " us\n"
+			<< "  mismatched table paths: " << mismatches << "\n";
+	}
 }
 
-std::vector<Trigger*> GameMap::Loader::loadTriggers() {
-	size_t dynamicObjectsSize;
-	float x, y;
-	std::string objectType, s;
-	std::vector<Trigger*> dynamicObjects;
-	_reader >> s >> dynamicObjectsSize;
-	dynamicObjects.reserve(dynamicObjectsSize);
-
-	for (size_t i = 0; i < dynamicObjectsSize; ++i) {
-		_reader >> objectType >> x >> y;
-		if (objectType == Config.MedPackName) {
-			dynamicObjects.push_back(TriggerFactory::create(TriggerType::HEALTH, Vector2(x, y)));
+void GameMap::benchmarkIncrementalPlanning(const Vector2& doorway, size_t queries) const {
+	int n = _navigationMesh.size();
+	if (n == 0) { return; }
+
+	// cieka przechodzi przez drzwi, jeeli ktrykolwiek jej uk ley w tej odlegoci od punktu doorway.
+	const float doorwayRadius = 60.0f;
+	const std::vector<common::Circle> doorwayArea = { common::Circle(doorway, doorwayRadius) };
+	std::vector<std::pair<int, int>> doorwayArcs;
+	getBlockedArcs(doorwayArea, doorwayArcs);
+
+	GameTime frequency = SDL_GetPerformanceFrequency();
+	GameTime incrementalTime = 0, fullTime = 0, from;
+	size_t scenarios = 0, mismatches = 0, incrementalExpansions = 0;
+	std::vector<int> path, initialPath;
+
+	for (size_t q = 0; q < queries; ++q) {
+		int start = Rng::getInteger(0, n - 1), goal = Rng::getInteger(0, n - 1);
+		if (!aStar(start, goal, {}, initialPath) || initialPath.size() < 2) { continue; }
+		bool passesDoorway = false;
+		for (size_t i = 1; i < initialPath.size() && !passesDoorway; ++i) {
+			auto arc = std::make_pair(std::min(initialPath[i - 1], initialPath[i]), std::max(initialPath[i - 1], initialPath[i]));
+			passesDoorway = std::binary_search(doorwayArcs.begin(), doorwayArcs.end(), arc);
 		}
-		else if (objectType == Config.ArmorPackName) {
-			dynamicObjects.push_back(TriggerFactory::create(TriggerType::ARMOR, Vector2(x, y)));
-		}
-		else {
-			dynamicObjects.push_back(TriggerFactory::create(objectType, Vector2(x, y)));
+		if (!passesDoorway) { continue; }
+		++scenarios;
+
+		std::vector<common::Circle> blockedAreas;
+
+		IncrementalPlanner planner(this, goal);
+		from = SDL_GetPerformanceCounter();
+		planner.findPath(start, {}, path);
+		incrementalTime += SDL_GetPerformanceCounter() - from;
+
+		// Obiekt utkn w tumie przed drzwiami i jest przez niego przepychany. Kolejne prby blokuj
+		// coraz wikszy obszar wok jego biecego pooenia, tak jak w Movable::recalculatePath.
+		for (int recalculation = 1; recalculation <= Config.MaxRecalculations; ++recalculation) {
+			Vector2 position = doorway + Vector2(Rng::getFloat(-15.0f, 15.0f), Rng::getFloat(-15.0f, 15.0f));
+			common::Circle area(position, 50.0f * (recalculation + 1));
+			blockedAreas.push_back(area);
+			int current = getClosestNavigationNode(position, blockedAreas);
+			if (current == NULL_IDX || current == goal) { break; }
+
+			from = SDL_GetPerformanceCounter();
+			planner.findPath(current, { area }, path);
+			incrementalTime += SDL_GetPerformanceCounter() - from;
+			float incrementalCost = path.empty() ? -1 : getPathCost(path);
+
+			from = SDL_GetPerformanceCounter();
+			aStar(current, goal, blockedAreas, path);
+			fullTime += SDL_GetPerformanceCounter() - from;
+			float fullCost = path.empty() ? -1 : getPathCost(path);
+
+			if (common::abs(incrementalCost - fullCost) > 0.01f) {
+				++mismatches;
+			}
 		}
+		incrementalExpansions += planner.getExpandedNodesCount();
 	}
 
-	return dynamicObjects;
+	std::cout << "D* Lite benchmark (" << n << " nodes, " << scenarios << " paths through the doorway, "
+		<< Config.MaxRecalculations << " recalculations each):\n"
+		<< "  A* from scratch: " << fullTime * 1000000 / frequency << " us\n"
+		<< "  D* Lite (including initial search): " << incrementalTime * 1000000 / frequency << " us, "
+		<< incrementalExpansions << " expansions\n"
+		<< "  mismatched path costs: " << mismatches << "\n";
 }
 
-#ifdef _DEBUG
-
-Vector2 GameMap::getClosest(const Vector2& point) const {
-	int idx = getClosestNavigationNode(point, {});
-	return idx != NULL_IDX ? _navigationMesh[idx].position : Vector2();
-}
+void GameMap::benchmarkPathCache(size_t queries) const {
+	int n = _navigationMesh.size();
+	if (n == 0) { return; }
+
+	// Obiekty zmierzajce do kilku celw utykaj w kilku miejscach. Obszar wok obiektu ma rodek
+	// w jego biecym pooeniu i promie zaleny od numeru prby, tak jak w Movable::recalculatePath.
+	const int hotspotsCount = 4, goalsCount = 4;
+	std::vector<int> hotspots, goals;
+	for (int i = 0; i < hotspotsCount; ++i) { hotspots.push_back(Rng::getInteger(0, n - 1)); }
+	for (int i = 0; i < goalsCount; ++i) { goals.push_back(Rng::getInteger(0, n - 1)); }
+
+	PathCache cache(Config.PathCacheSize);
+	GameTime frequency = SDL_GetPerformanceFrequency();
+	GameTime cachedTime = 0, uncachedTime = 0, from;
+	size_t scenarios = 0, mismatches = 0;
+	std::vector<int> path;
+	std::vector<std::pair<int, int>> blockedArcs;
+
+	for (size_t q = 0; q < queries; ++q) {
+		Vector2 position = getNodePosition(hotspots[q % hotspotsCount])
+			+ Vector2(Rng::getFloat(-20.0f, 20.0f), Rng::getFloat(-20.0f, 20.0f));
+		int recalculation = Rng::getInteger(0, std::max(0, Config.MaxRecalculations - 1));
+		std::vector<common::Circle> areas = { common::Circle(position, 50.0f * (recalculation + 1)) };
+		int start = getClosestNavigationNode(position, areas);
+		int goal = goals[Rng::getInteger(0, goalsCount - 1)];
+		if (start == NULL_IDX || isInIgnoredArea(getNodePosition(goal), areas)) { continue; }
+		++scenarios;
+
+		from = SDL_GetPerformanceCounter();
+		getBlockedArcs(areas, blockedArcs);
+		if (!cache.find(start, goal, blockedArcs, path)) {
+			aStar(start, goal, areas, path);
+			cache.insert(start, goal, blockedArcs, path);
+		}
+		cachedTime += SDL_GetPerformanceCounter() - from;
+		float cachedCost = path.empty() ? -1 : getPathCost(path);
 
-std::vector<Vector2> GameMap::getNavigationNodes() const {
-	std::vector<Vector2> result;
-	result.reserve(_navigationMesh.size());
-	for (NavigationNode node : _navigationMesh) {
-		result.push_back(node.position);
-	}
-	return result;
-}
+		from = SDL_GetPerformanceCounter();
+		aStar(start, goal, areas, path);
+		uncachedTime += SDL_GetPerformanceCounter() - from;
+		float uncachedCost = path.empty() ? -1 : getPathCost(path);
 
-std::vector<Segment> GameMap::getNavigationArcs() const {
-	std::vector<Segment> result;
-	for (NavigationNode node : _navigationMesh) {
-		Vector2 from = node.position;
-		for (auto arc : node.arcs) {
-			result.push_back(Segment(from, _navigationMesh.at(arc.first).position));
+		if (common::abs(cachedCost - uncachedCost) > 0.01f) {
+			++mismatches;
 		}
 	}
-	return result;
+
+	size_t hits = cache.getHits(), misses = cache.getMisses();
+	std::cout << "Path cache benchmark (" << n << " nodes, " << scenarios << " queries around "
+		<< hotspotsCount << " hotspots, capacity " << cache.getCapacity() << "):\n"
+		<< "  hits: " << hits << ", misses: " << misses << ", hit rate: "
+		<< (hits + misses > 0 ? 100.0 * hits / (hits + misses) : 0.0) << "%\n"
+		<< "  A* only: " << uncachedTime * 1000000 / frequency << " us\n"
+		<< "  with cache: " << cachedTime * 1000000 / frequency << " us\n"
+		<< "  mismatched path costs: " << mismatches << "\n";
 }
 
+void GameMap::benchmarkFlowFields(size_t actors, size_t targets) const {
+	int n = _navigationMesh.size();
+	if (n == 0 || targets == 0) { return; }
 
-void GameMap::Loader::generateConnections(const String& inputFile, const String& outputFile) {
+	std::vector<int> goals, starts;
+	for (size_t i = 0; i < targets; ++i) { goals.push_back(Rng::getInteger(0, n - 1)); }
+	for (size_t i = 0; i < actors; ++i) { starts.push_back(Rng::getInteger(0, n - 1)); }
 
-	_reader.open(inputFile);
+	GameTime frequency = SDL_GetPerformanceFrequency();
+	GameTime from, aStarTime, flowFieldTime;
+	std::vector<int> path;
+	size_t mismatches = 0;
+	std::vector<float> aStarCosts;
 
-	if (_reader.fail()) {
-		throw "Plik '" + String(inputFile) + "' nie istnieje, jest niedostpny lub uszkodzony.";
+	from = SDL_GetPerformanceCounter();
+	for (size_t i = 0; i < actors; ++i) {
+		aStar(starts[i], goals[i % targets], {}, path);
+		aStarCosts.push_back(path.empty() ? -1 : getPathCost(path));
 	}
+	aStarTime = SDL_GetPerformanceCounter() - from;
+
+	// Kade pole jest wyznaczane raz, a nastpnie odczytywane przez wszystkie obiekty zmierzajce do jego celu.
+	from = SDL_GetPerformanceCounter();
+	std::vector<std::shared_ptr<const FlowField>> fields;
+	for (int goal : goals) { fields.push_back(computeFlowField(goal)); }
+	for (size_t i = 0; i < actors; ++i) {
+		fields[i % targets]->getPath(starts[i], path);
+	}
+	flowFieldTime = SDL_GetPerformanceCounter() - from;
 
-	int width, height, size;
-	std::vector<NavigationNode> points;
-	std::vector<Wall> walls;
-
-	float epsilon = common::EPSILON;
+	for (size_t i = 0; i < actors; ++i) {
+		float cost = fields[i % targets]->getPath(starts[i], path) ? getPathCost(path) : -1;
+		if (common::abs(cost - aStarCosts[i]) > 0.01f) {
+			++mismatches;
+		}
+	}
 
-	String s;
-	_reader >> s >> width >> s >> height;
+	std::cout << "Flow field benchmark (" << n << " nodes, " << actors << " actors, " << targets << " targets):\n"
+		<< "  A* per actor: " << aStarTime * 1000000 / frequency << " us\n"
+		<< "  shared flow fields: " << flowFieldTime * 1000000 / frequency << " us\n"
+		<< "  mismatched path costs: " << mismatches << "\n";
+}
 
-	int idx;
-	float posX, posY;
-	_reader >> s >> size;
+void GameMap::benchmarkHierarchicalPathfinding(size_t queries) {
+	const float spacing = 30.0f;
+	const float blockedFraction = 0.15f;
+	GameTime frequency = SDL_GetPerformanceFrequency();
 
-	points.reserve(size);
+	std::cout << "HPA* benchmark (" << queries << " queries per map, cluster size "
+		<< Config.HierarchicalClusterSize << "):\n";
 
-	for (int i = 0; i < size; i++) {
-		_reader >> s >> idx >> s >> posX >> s >> posY;
-		points.push_back(NavigationNode(posX, posY, idx));
-	}
+	// Siatki wzw z ukami do 8 ssiadw, z losowo usunitymi wzami (przeszkodami).
+	for (int side = 20; side <= 160; side *= 2) {
+		GameMap map;
+		map._width = side * spacing;
+		map._height = side * spacing;
 
-	float x1, y1, x2, y2, id, p;
-	String objectType;
-	
-	_reader >> s >> size;
-	walls.reserve(size);
+		std::vector<bool> blocked(side * side);
+		for (int i = 0; i < side * side; ++i) {
+			blocked[i] = Rng::getFloat(0, 1) < blockedFraction;
+			map._navigationMesh.push_back(NavigationNode((i % side + 0.5f) * spacing, (i / side + 0.5f) * spacing, i));
+		}
 
-	for (int i = 0; i < size; i++) {
-		_reader >> objectType;
-		if (objectType == "wall:") {
-			_reader >> x1 >> y1 >> x2 >> y2 >> s >> id >> s >> p;
-			Vector2 from(x1, y1), to(x2, y2);
-			if (common::sqDist(from, to) > epsilon) {
-				walls.push_back(Wall(id, Vector2(x1, y1), Vector2(x2, y2), p));
+		for (int i = 0; i < side * side; ++i) {
+			if (blocked[i]) { continue; }
+			int x = i % side, y = i / side;
+			for (int dy = -1; dy <= 1; ++dy) {
+				for (int dx = -1; dx <= 1; ++dx) {
+					int nx = x + dx, ny = y + dy;
+					if ((dx == 0 && dy == 0) || nx < 0 || ny < 0 || nx >= side || ny >= side) { continue; }
+					int j = ny * side + nx;
+					if (!blocked[j]) {
+						map._navigationMesh[i].arcs.push_back(NavigationNode::Arc(j,
+							common::distance(map._navigationMesh[i].position, map._navigationMesh[j].position)));
+					}
+				}
 			}
 		}
-		else {
-			throw "Nieprawidowa struktura pliku mapy! Nie rozpoznano: '" + objectType + "'.";
-		}
-	}
 
-	_reader.close();
-	
-	float k = Config.ActorRadius;
-	
-	// Jeeli poczenie przechodzi zbyt blisko ciany, to odrzucamy je.
-	auto condition1 = [&walls](const Segment& s, float distance) -> bool {
-		distance *= distance;
-		for (auto elem : walls) {
-			if (common::sqDist(s, elem.getSegment()) < distance) { 
-				return true; 
-			} 
+		std::vector<Vector2> positions;
+		std::vector<std::vector<NavigationNode::Arc>> arcs;
+		for (const NavigationNode& node : map._navigationMesh) {
+			positions.push_back(node.position);
+			arcs.push_back(node.arcs);
 		}
-		return false;
-	};
 
-	// Jeel punkt nawigacji (inny ni rozwaane poczenie) naley do poczenia, odrzucamy je.
-	auto condition2 = [&points](const Segment& s) -> bool {
-		float epsilon = common::EPSILON;
-		for (NavigationNode node : points) {
-			Vector2 point = node.position;
-			if (common::sqDist(point, s.from) > epsilon
-				&& common::sqDist(point, s.to) > epsilon
-				&& common::distance(point, s) < epsilon) {
-				return true;
+		GameTime from = SDL_GetPerformanceCounter();
+		HierarchicalGraph hierarchy(positions, arcs, map._width, map._height, Config.HierarchicalClusterSize);
+		GameTime buildTime = SDL_GetPerformanceCounter() - from;
+
+		std::vector<std::pair<int, int>> pairs;
+		std::vector<int> path;
+		while (pairs.size() < queries) {
+			int first = Rng::getInteger(0, side * side - 1);
+			int second = Rng::getInteger(0, side * side - 1);
+			if (!blocked[first] && !blocked[second] && map.aStar(first, second, {}, path)) {
+				pairs.push_back(std::make_pair(first, second));
 			}
 		}
-		return false;
-	};
-
-	int n = points.size();
-	NavigationNode* first;
-	NavigationNode* second;
-	Vector2 tempVector;
 
-	std::ofstream myfile;
-	myfile.open(outputFile);
-
-	myfile << "width: " << width << " height: " << height << "\n\n";
-
-	myfile << "navigation_points: " << n << "\n";
-	for (int i = 0; i < n; ++i) {
-		myfile << "id: " << points[i].index
-			<< " x: " << points[i].position.x
-			<< " y: " << points[i].position.y << "\n";
-	}
+		from = SDL_GetPerformanceCounter();
+		for (const auto& query : pairs) {
+			map.aStar(query.first, query.second, {}, path);
+		}
+		GameTime flatTime = SDL_GetPerformanceCounter() - from;
 
-	std::vector<String> connections;
-	for (int i = 0; i < n; ++i) {
-		first = &points.at(i);
-		for (int j = i; j < n; ++j) {
-			second = &points.at(j);
-			const Segment arc = Segment(first->position, second->position);
-			if (first->index < second->index
-				&& !condition1(arc, k)
-				&& !condition2(arc)) {
-				connections.push_back("from: " + std::to_string(first->index)
-					+ " to: " + std::to_string(second->index) + " mul: 1.0 inv: 1\n");
+		from = SDL_GetPerformanceCounter();
+		for (const auto& query : pairs) {
+			hierarchy.findPath(query.first, query.second, {}, path);
+		}
+		GameTime hierarchicalTime = SDL_GetPerformanceCounter() - from;
+
+		// redni stosunek dugoci cieki HPA* do dugoci cieki optymalnej.
+		float ratioSum = 0;
+		size_t failures = 0;
+		for (const auto& query : pairs) {
+			if (!hierarchy.findPath(query.first, query.second, {}, path)) {
+				++failures;
+				continue;
 			}
+			float hierarchicalCost = map.getPathCost(path);
+			map.aStar(query.first, query.second, {}, path);
+			float flatCost = map.getPathCost(path);
+			ratioSum += flatCost > 0 ? hierarchicalCost / flatCost : 1;
 		}
-	}
 
-	myfile << "\nconnections: " << connections.size() << "\n";
-	for (const String& connection : connections) {
-		myfile << connection;
+		std::cout << "  " << side * side << " nodes, " << hierarchy.getClustersCount() << " clusters, "
+			<< hierarchy.getEntrancesCount() << " entrances:\n"
+			<< "    build: " << buildTime * 1000000 / frequency << " us\n"
+			<< "    A*: " << flatTime * 1000000 / frequency << " us\n"
+			<< "    HPA*: " << hierarchicalTime * 1000000 / frequency << " us\n"
+			<< "    path length ratio: " << ratioSum / common::max(1, (int)(pairs.size() - failures)) << "\n"
+			<< "    failed queries: " << failures << "\n";
 	}
+}
 
-	myfile << "\n";
-	for (const Wall& wall : walls) {
-		Segment s = wall.getSegment();
-		myfile << "wall: " << s.from.x << " " << s.from.y << " "
-			<< s.to.x << " " << s.to.y << " id: "
-			<< wall.getId() << " priority: " << wall.getPriority() << "\n";
+std::vector<Vector2> GameMap::getNavigationNodes() const {
+	std::vector<Vector2> result;
+	result.reserve(_navigationMesh.size());
+	for (NavigationNode node : _navigationMesh) {
+		result.push_back(node.position);
 	}
+	return result;
+}
 
-	myfile.close();
+std::vector<Segment> GameMap::getNavigationArcs() const {
+	std::vector<Segment> result;
+	for (NavigationNode node : _navigationMesh) {
+		Vector2 from = node.position;
+		for (auto arc : node.arcs) {
+			result.push_back(Segment(from, _navigationMesh.at(arc.first).position));
+		}
+	}
+	return result;
 }
 
 #endif
@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <fstream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <queue>
 #include <string>
 #include <vector>
@@ -12,6 +14,11 @@
 #include "SegmentTree.h"
 #include "main/Configuration.h"
 #include "engine/RegularGrid.h"
+#include "engine/PathCache.h"
+#include "engine/HierarchicalGraph.h"
+#include "engine/IncrementalPlanner.h"
+#include "engine/FlowField.h"
+#include "engine/Path.h"
 
 class DynamicEntity;
 class Actor;
@@ -20,8 +27,13 @@ class Wall;
 
 class GameMap {
 public:
+	static const String COMPILED_MAP_EXTENSION;
+
 	static GameMap* create(const char* filepath);
 	static void generateConnections(const String& inputFile, const String& outputFile);
+	// Zapisuje map w formacie binarnym, wczytywanym zamiast pliku tekstowego, jeeli znajduje si
+	// obok niego (nazwa pliku mapy z rozszerzeniem COMPILED_MAP_EXTENSION) i zosta utworzony z jego biecej zawartoci.
+	static void compile(const String& inputFile, const String& outputFile);
 	static void destroy(GameMap* game);
 
 	float getWidth() const;
@@ -31,10 +43,36 @@ public:
 	std::vector<Trigger*> getTriggers() const;
 	std::vector<StaticEntity*> getWalls() const;
 
-	std::queue<Vector2> findPath(const Vector2& from, const Vector2& to, Movable* movable) const;
-	std::queue<Vector2> findPath(const Vector2& from, const Vector2& to, Movable* movable, const std::vector<common::Circle>& ignoredAreas) const;
+	// Wyznacza ciek dla obiektu o promieniu radius. Odczytuje wycznie dane statyczne mapy,
+	// wic moe by wywoywana przez wtki usugi planowania cieek.
+	Path findPath(const Vector2& from, const Vector2& to, float radius) const;
+	Path findPath(const Vector2& from, const Vector2& to, float radius, const std::vector<common::Circle>& ignoredAreas) const;
+	// Naprawia ciek do punktu to po zablokowaniu obszaru blockedArea, korzystajc ze stanu wyszukiwania
+	// zachowanego przez obiekt. Planer prowadzcy do innego celu jest przywracany do stanu pocztkowego.
+	// Wywoywana przez wtki usugi planowania cieek.
+	Path replan(IncrementalPlanner& planner, const Vector2& from, const Vector2& to,
+		float radius, const common::Circle& blockedArea) const;
+	// Wyznacza pole kierunkw do wza target przeszukujc graf od celu po ukach odwrconych.
+	std::shared_ptr<const FlowField> computeFlowField(int target) const;
+	// cieka do punktu to odczytana z pola kierunkw, wygadzona tak jak wynik findPath.
+	Path followFlowField(const FlowField& field, const Vector2& from, const Vector2& to, Movable* movable) const;
+	int getClosestNavigationNode(const Vector2& point) const;
 	bool raycastStatic(const Segment& ray, Vector2& result) const;
 
+	size_t getPathCacheHits() const;
+	size_t getPathCacheMisses() const;
+
+	// czna liczba punktw i dugo cieek przed wygadzeniem i po nim.
+	struct PathSmoothingStatistics {
+		size_t paths = 0;
+		size_t rawWaypoints = 0;
+		size_t smoothedWaypoints = 0;
+		double rawLength = 0;
+		double smoothedLength = 0;
+	};
+
+	PathSmoothingStatistics getPathSmoothingStatistics() const;
+
 	bool canPlace(const DynamicEntity* object) const;
 	bool place(Actor* actor);
 	bool place(Trigger* trigger);
@@ -53,6 +91,21 @@ public:
 	Vector2 getClosest(const Vector2& point) const;
 	std::vector<Vector2> getNavigationNodes() const;
 	std::vector<Segment> getNavigationArcs() const;
+
+	// Porwnuje czas dziaania biecej i pierwotnej implementacji A* na losowych parach wzw.
+	void benchmarkPathfinding(size_t queries) const;
+	// Porwnuje A* i HPA* na syntetycznych mapach o rosncej liczbie wzw.
+	static void benchmarkHierarchicalPathfinding(size_t queries);
+	// Porwnuje napraw cieki przez D* Lite z ponownym wyszukiwaniem A* dla obiektw, ktre utkny
+	// w zatoczonych drzwiach w punkcie doorway (np. (180, 362) na mapie six_rooms.map) i przy kolejnych
+	// prbach blokuj coraz wiksze obszary wok swojego pooenia.
+	void benchmarkIncrementalPlanning(const Vector2& doorway, size_t queries) const;
+	// Mierzy skuteczno pamici podrcznej cieek dla zapyta z ignorowanymi obszarami wok kilku
+	// zatoczonych miejsc (rodki i promienie obszarw rni si przy kadej prbie).
+	void benchmarkPathCache(size_t queries) const;
+	// Porwnuje A* wykonywane osobno dla kadego obiektu ze wspdzielonymi polami kierunkw
+	// dla wielu obiektw zmierzajcych do kilku wsplnych celw.
+	void benchmarkFlowFields(size_t actors, size_t targets) const;
 #endif
 
 private:
@@ -62,39 +115,114 @@ private:
 		int index;
 		typedef std::pair<int, float> Arc;
 		std::vector<Arc> arcs;
+		// uki prowadzce do wza (indeks wza pocztkowego i koszt).
+		std::vector<Arc> reverseArcs;
 
 		NavigationNode(float x, float y, int index);
 	};
 
+	// Komrka indeksu przestrzennego wzw nawigacji.
+	struct NavigationCell {
+		std::vector<int> nodes;
+		// Posortowane indeksy pobliskich wzw widocznych z kadego punktu komrki.
+		std::vector<int> visibleNodes;
+		// uki (pary wzw, mniejszy indeks pierwszy), ktre mog przecina komrk.
+		std::vector<std::pair<int, int>> arcs;
+	};
+
 	float _width;
 	float _height;
 	std::vector<NavigationNode> _navigationMesh;
+	std::vector<NavigationCell> _navigationCells;
+	float _navigationCellSize;
+	int _navigationCellsX;
+	int _navigationCellsY;
+	// Pierwszy krok i dugo najkrtszej cieki dla kadej pary wzw (wiersz odpowiada wzowi
+	// pocztkowemu). Puste, jeeli liczba wzw przekracza Config.NextHopTableMaxNodes.
+	// Dugoci su jako heurystyka A* przy wyszukiwaniu z ignorowanymi obszarami.
+	std::vector<int> _nextHop;
+	std::vector<float> _pathDistances;
 	CollisionResolver* _collisionResolver;
+	PathCache* _pathCache;
+	// Graf hierarchiczny (nullptr, jeeli wzw jest mniej ni Config.HierarchicalPathfindingMinNodes).
+	HierarchicalGraph* _hierarchy;
 	std::vector<Trigger*> _triggers;
 	std::vector<Actor*> _entities;
 	std::vector<StaticEntity*> _walls;
+	mutable std::mutex _smoothingStatisticsMutex;
+	mutable PathSmoothingStatistics _smoothingStatistics;
 
 	int getClosestNavigationNode(const Vector2& point, const std::vector<common::Circle>& ignoredAreas) const;
-	std::vector<int> aStar(int from, int to, const std::vector<common::Circle>& ignoredAreas) const;
+	int getNavigationCellX(float x) const;
+	int getNavigationCellY(float y) const;
+	const NavigationCell& getNavigationCell(int i, int j) const;
+	// Wyznacza posortowany zbir ukw przechodzcych przez obszary areas, przegldajc tylko uki
+	// zapisane w komrkach siatki nawigacji pokrywajcych obszary.
+	void getBlockedArcs(const std::vector<common::Circle>& areas, std::vector<std::pair<int, int>>& arcs) const;
+	bool hasNextHopTable() const;
+	bool walkNextHopTable(int from, int to, std::vector<int>& path) const;
+	bool aStar(int from, int to, const std::vector<common::Circle>& ignoredAreas, std::vector<int>& path) const;
 	float estimateDistance(int fromIdx, int toIdx) const;
+	// Dugo najkrtszej cieki w penym grafie nawigacji, jeeli dostpna jest tablica _pathDistances,
+	// a w przeciwnym razie odlego w linii prostej. Ignorowane obszary jedynie usuwaj uki z grafu,
+	// wic obie wartoci s spjnymi heurystykami dla A*; dokadna odlego ogranicza liczb
+	// rozwijanych wzw do tych, ktre le w pobliu objazdu zablokowanego obszaru.
+	float estimatePathDistance(int fromIdx, int toIdx) const;
 	Vector2 getNodePosition(int index) const;
+	// Usuwa zbdne punkty cieki (zapisanej od celu do startu, jak w aStar), zastpujc je odcinkami
+	// zachowujcymi odstp od cian zaleny od promienia poruszajcego si obiektu.
+	void smoothPath(const Vector2& from, const Vector2& to, float radius, const std::vector<int>& pathIndices, Path& result) const;
 
 	static const int NULL_IDX;
+	// Odlego (w komrkach) wzw, dla ktrych wyznaczana jest widoczno z caej komrki.
+	static const int NAVIGATION_VISIBILITY_RANGE;
+	static const String NEXT_HOP_FILE_EXTENSION;
+	static const unsigned int NEXT_HOP_FILE_HEADER;
+	static const unsigned int NEXT_HOP_FILE_VERSION;
+
+#ifdef _DEBUG
+	std::vector<int> aStarReference(int from, int to, const std::vector<common::Circle>& ignoredAreas) const;
+	float getPathCost(const std::vector<int>& path) const;
+#endif
+
 
+	friend class IncrementalPlanner;
 
 	class Loader {
 	public:
 		GameMap* load(const char* mapFilename);
 		void generateConnections(const String& inputFile, const String& outputFile); 
+		void compile(const String& inputFile, const String& outputFile);
 
 	private:
+		struct TriggerSpawn {
+			String type;
+			Vector2 position;
+		};
+
+		void loadText(const String& mapFilename, std::vector<TriggerSpawn>& triggers);
+		bool loadCompiled(const String& filename, const String& sourceFilename, std::vector<TriggerSpawn>& triggers);
+		void saveCompiled(const String& filename, const String& sourceFilename, const std::vector<TriggerSpawn>& triggers) const;
 		void loadMapSize();
 		void loadNavigationPoints();
 		void loadNavigationMesh();
+		void buildNavigationGrid();
+		void buildNavigationArcIndex();
+		void prepareNextHopTable(const String& mapFilename);
+		void buildNavigationHierarchy();
+		void buildReverseArcs();
+		void buildNextHopTable();
+		bool loadNextHopTable(const String& filename, unsigned long long checksum);
+		void saveNextHopTable(const String& filename, unsigned long long checksum);
+		unsigned long long computeNavigationChecksum() const;
 		std::vector<StaticEntity*> loadStaticObjects();
-		std::vector<Trigger*> loadTriggers();
+		std::vector<TriggerSpawn> loadTriggers();
+		std::vector<Trigger*> createTriggers(const std::vector<TriggerSpawn>& triggers);
 		
 		GameMap* _map;
 		std::ifstream _reader;
 	};
 };
+
+bool isInIgnoredArea(const Vector2& point, const std::vector<common::Circle>& ignoredAreas);
+bool isArcInIgnoredArea(const Segment& arc, const std::vector<common::Circle>& ignoredAreas);
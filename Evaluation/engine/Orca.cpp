@@ -0,0 +1,181 @@
+#include "Orca.h"
+#include "engine/CollisionResolver.h"
+#include "entities/Entity.h"
+#include "main/Configuration.h"
+
+OrcaLine computeOrcaLine(const Vector2& relativePosition, const Vector2& velocity, const Vector2& otherVelocity,
+	float combinedRadius, float timeHorizon, float responsibility) {
+
+	OrcaLine line;
+	Vector2 relativeVelocity = velocity - otherVelocity;
+	float distSq = relativePosition.lengthSquared();
+	float combinedRadiusSq = combinedRadius * combinedRadius;
+	Vector2 u;
+
+	if (distSq > combinedRadiusSq) {
+		// Obiekty nie koliduj. Wektor w czy rodek citego stoka VO z prdkoci wzgldn.
+		Vector2 w = relativeVelocity - relativePosition / timeHorizon;
+		float wLengthSq = w.lengthSquared();
+		float dotProduct = w.dot(relativePosition);
+
+		if (dotProduct < 0 && dotProduct * dotProduct > combinedRadiusSq * wLengthSq) {
+			// Rzut na okrg ograniczajcy stoek od strony wierzchoka.
+			float wLength = sqrtf(wLengthSq);
+			Vector2 unitW = w / wLength;
+			line.direction = Vector2(unitW.y, -unitW.x);
+			u = unitW * (combinedRadius / timeHorizon - wLength);
+		}
+		else {
+			// Rzut na jedno z ramion stoka.
+			float leg = sqrtf(distSq - combinedRadiusSq);
+			if (common::cross(relativePosition, w) > 0) {
+				line.direction = Vector2(relativePosition.x * leg - relativePosition.y * combinedRadius,
+					relativePosition.x * combinedRadius + relativePosition.y * leg) / distSq;
+			}
+			else {
+				line.direction = -Vector2(relativePosition.x * leg + relativePosition.y * combinedRadius,
+					-relativePosition.x * combinedRadius + relativePosition.y * leg) / distSq;
+			}
+			u = line.direction * relativeVelocity.dot(line.direction) - relativeVelocity;
+		}
+	}
+	else {
+		// Obiekty ju koliduj, wic naley je rozsun w cigu jednej klatki.
+		Vector2 w = relativeVelocity - relativePosition;
+		float wLength = w.length();
+		Vector2 unitW = wLength > common::EPSILON ? w / wLength : Vector2(1, 0);
+		line.direction = Vector2(unitW.y, -unitW.x);
+		u = unitW * (combinedRadius - wLength);
+	}
+
+	line.point = velocity + u * responsibility;
+	return line;
+}
+
+OrcaLine computeObstacleLine(const Vector2& position, const Vector2& closestPoint, float radius, float timeHorizon) {
+	Vector2 away = position - closestPoint;
+	float distance = away.length();
+	Vector2 normal = distance > common::EPSILON ? away / distance : Vector2(1, 0);
+
+	OrcaLine line;
+	line.point = normal * ((radius - distance) / timeHorizon);
+	line.direction = Vector2(normal.y, -normal.x);
+	return line;
+}
+
+void computeObstacleLines(const CollisionResolver* collisionResolver, const Vector2& position, float radius, float maxSpeed,
+	std::vector<OrcaLine>& lines) {
+
+	float range = radius + maxSpeed * Config.OrcaObstacleTimeHorizon;
+	for (StaticEntity* wall : collisionResolver->broadphaseStatic(position, range)) {
+		for (const Segment& segment : wall->getBounds()) {
+			Vector2 direction = segment.to - segment.from;
+			float lengthSq = direction.lengthSquared();
+			float t = lengthSq > common::EPSILON ? common::clamp((position - segment.from).dot(direction) / lengthSq, 0, 1) : 0;
+			Vector2 closestPoint = segment.from + direction * t;
+			if (common::sqDist(position, closestPoint) <= common::sqr(range)) {
+				lines.push_back(computeObstacleLine(position, closestPoint, radius, Config.OrcaObstacleTimeHorizon));
+			}
+		}
+	}
+}
+
+// Optymalizacja na prostej lineIdx z uwzgldnieniem wczeniejszych ogranicze.
+bool solveOnLine(const std::vector<OrcaLine>& lines, size_t lineIdx, float radius,
+	const Vector2& optimalVelocity, bool optimizeDirection, Vector2& result) {
+
+	const OrcaLine& line = lines[lineIdx];
+	float dotProduct = line.point.dot(line.direction);
+	float discriminant = dotProduct * dotProduct + radius * radius - line.point.lengthSquared();
+	if (discriminant < 0) { return false; }
+
+	float sqrtDiscriminant = sqrtf(discriminant);
+	float tLeft = -dotProduct - sqrtDiscriminant;
+	float tRight = -dotProduct + sqrtDiscriminant;
+
+	for (size_t i = 0; i < lineIdx; ++i) {
+		float denominator = common::cross(line.direction, lines[i].direction);
+		float numerator = common::cross(lines[i].direction, line.point - lines[i].point);
+		if (common::abs(denominator) <= common::EPSILON) {
+			// Proste rwnolege.
+			if (numerator < 0) { return false; }
+			continue;
+		}
+		float t = numerator / denominator;
+		if (denominator >= 0) { tRight = common::min(tRight, t); }
+		else { tLeft = common::max(tLeft, t); }
+		if (tLeft > tRight) { return false; }
+	}
+
+	if (optimizeDirection) {
+		result = line.point + line.direction * (optimalVelocity.dot(line.direction) > 0 ? tRight : tLeft);
+	}
+	else {
+		float t = common::clamp(line.direction.dot(optimalVelocity - line.point), tLeft, tRight);
+		result = line.point + line.direction * t;
+	}
+	return true;
+}
+
+// Zwraca indeks pierwszego ograniczenia, ktrego nie udao si speni, lub liczb ogranicze.
+size_t solvePlanar(const std::vector<OrcaLine>& lines, float radius, const Vector2& optimalVelocity,
+	bool optimizeDirection, Vector2& result) {
+
+	if (optimizeDirection) { result = optimalVelocity * radius; }
+	else if (optimalVelocity.lengthSquared() > radius * radius) { result = optimalVelocity.normal() * radius; }
+	else { result = optimalVelocity; }
+
+	for (size_t i = 0; i < lines.size(); ++i) {
+		if (common::cross(lines[i].direction, lines[i].point - result) > 0) {
+			Vector2 previous = result;
+			if (!solveOnLine(lines, i, radius, optimalVelocity, optimizeDirection, result)) {
+				result = previous;
+				return i;
+			}
+		}
+	}
+	return lines.size();
+}
+
+// Minimalizacja najwikszego naruszenia ogranicze od firstLine (trjwymiarowy program liniowy
+// sprowadzony do cigu programw dwuwymiarowych).
+void solveInfeasible(const std::vector<OrcaLine>& lines, size_t obstacleLines, size_t firstLine, float radius, Vector2& result) {
+	float distance = 0;
+	std::vector<OrcaLine> projectedLines;
+
+	for (size_t i = firstLine; i < lines.size(); ++i) {
+		if (common::cross(lines[i].direction, lines[i].point - result) > distance) {
+			projectedLines.assign(lines.begin(), lines.begin() + obstacleLines);
+			for (size_t j = obstacleLines; j < i; ++j) {
+				OrcaLine line;
+				float determinant = common::cross(lines[i].direction, lines[j].direction);
+				if (common::abs(determinant) <= common::EPSILON) {
+					if (lines[i].direction.dot(lines[j].direction) > 0) { continue; }
+					line.point = (lines[i].point + lines[j].point) * 0.5f;
+				}
+				else {
+					line.point = lines[i].point + lines[i].direction
+						* (common::cross(lines[j].direction, lines[i].point - lines[j].point) / determinant);
+				}
+				line.direction = (lines[j].direction - lines[i].direction).normal();
+				projectedLines.push_back(line);
+			}
+
+			Vector2 previous = result;
+			if (solvePlanar(projectedLines, radius, Vector2(-lines[i].direction.y, lines[i].direction.x), true, result) < projectedLines.size()) {
+				// Wynik moe nie spenia ogranicze tylko z powodu bdw numerycznych.
+				result = previous;
+			}
+			distance = common::cross(lines[i].direction, lines[i].point - result);
+		}
+	}
+}
+
+Vector2 solveOrcaProgram(const std::vector<OrcaLine>& lines, size_t obstacleLines, float maxSpeed, const Vector2& preferredVelocity) {
+	Vector2 result;
+	size_t failedLine = solvePlanar(lines, maxSpeed, preferredVelocity, false, result);
+	if (failedLine < lines.size()) {
+		solveInfeasible(lines, obstacleLines, failedLine, maxSpeed, result);
+	}
+	return result;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+#include "math/Math.h"
+
+class CollisionResolver;
+
+// Ppaszczyzna dopuszczalnych prdkoci. Dopuszczalne s prdkoci lece po lewej stronie
+// prostej przechodzcej przez point w kierunku direction (wektor jednostkowy).
+struct OrcaLine {
+	Vector2 point;
+	Vector2 direction;
+};
+
+// Ppaszczyzna ORCA dla pary obiektw (wzajemne unikanie kolizji), wyznaczona dla przedziau
+// czasu timeHorizon (w klatkach). Cz responsibility koniecznej zmiany prdkoci przypada
+// obiektowi, dla ktrego wyznaczana jest ppaszczyzna (0.5 dla obiektw poruszajcych si).
+OrcaLine computeOrcaLine(const Vector2& relativePosition, const Vector2& velocity, const Vector2& otherVelocity,
+	float combinedRadius, float timeHorizon, float responsibility);
+
+// Ppaszczyzna wykluczajca zblienie do punktu ciany closestPoint na odlego mniejsz ni radius
+// w cigu timeHorizon klatek.
+OrcaLine computeObstacleLine(const Vector2& position, const Vector2& closestPoint, float radius, float timeHorizon);
+
+// Dodaje do lines ppaszczyzny dla cian, do ktrych obiekt o danym promieniu i prdkoci maksymalnej
+// mgby dotrze w czasie Config.OrcaObstacleTimeHorizon.
+void computeObstacleLines(const CollisionResolver* collisionResolver, const Vector2& position, float radius, float maxSpeed,
+	std::vector<OrcaLine>& lines);
+
+// Wybiera prdko najblisz preferowanej spord prdkoci o dugoci nie wikszej ni maxSpeed
+// speniajcych wszystkie ograniczenia (dwuwymiarowe programowanie liniowe). Pierwsze obstacleLines
+// ogranicze pochodzi od cian i nie moe zosta naruszone. Jeeli pozostaych nie da si speni
+// jednoczenie, wybierana jest prdko minimalizujca najwiksze naruszenie.
+Vector2 solveOrcaProgram(const std::vector<OrcaLine>& lines, size_t obstacleLines, float maxSpeed, const Vector2& preferredVelocity);
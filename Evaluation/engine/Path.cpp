@@ -0,0 +1,30 @@
+#include "Path.h"
+
+Path::Path() : _cursor(0) {}
+
+bool Path::isEmpty() const { return _cursor == _waypoints.size(); }
+
+size_t Path::getSize() const { return _waypoints.size() - _cursor; }
+
+void Path::clear() {
+	_waypoints.clear();
+	_lengths.clear();
+	_cursor = 0;
+}
+
+void Path::push(const Vector2& waypoint) {
+	_lengths.push_back(_waypoints.empty() ? 0 : _lengths.back() + common::distance(_waypoints.back(), waypoint));
+	_waypoints.push_back(waypoint);
+}
+
+void Path::advance() { ++_cursor; }
+
+const Vector2& Path::getNext() const { return _waypoints[_cursor]; }
+
+const Vector2& Path::getGoal() const { return _waypoints.back(); }
+
+float Path::getRemainingLength() const { return isEmpty() ? 0 : _lengths.back() - _lengths[_cursor]; }
+
+std::vector<Vector2>::const_iterator Path::begin() const { return _waypoints.begin() + _cursor; }
+
+std::vector<Vector2>::const_iterator Path::end() const { return _waypoints.end(); }
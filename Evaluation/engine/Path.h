@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+#include "math/Math.h"
+
+// cieka przechowywana w cigej tablicy wraz z indeksem nastpnego punktu. Odwiedzone punkty
+// nie s usuwane, a sumy prefiksowe dugoci odcinkw pozwalaj wyznaczy pozosta dugo w czasie O(1).
+class Path {
+public:
+	Path();
+
+	bool isEmpty() const;
+	// Liczba punktw, ktre nie zostay jeszcze odwiedzone.
+	size_t getSize() const;
+	void clear();
+
+	void push(const Vector2& waypoint);
+	// Oznacza nastpny punkt jako odwiedzony.
+	void advance();
+
+	const Vector2& getNext() const;
+	const Vector2& getGoal() const;
+	// Dugo amanej od nastpnego punktu do celu.
+	float getRemainingLength() const;
+
+	// Zakres punktw, ktre nie zostay jeszcze odwiedzone.
+	std::vector<Vector2>::const_iterator begin() const;
+	std::vector<Vector2>::const_iterator end() const;
+
+private:
+	std::vector<Vector2> _waypoints;
+	// _lengths[i] to dugo amanej od pierwszego punktu do punktu i.
+	std::vector<float> _lengths;
+	size_t _cursor;
+};
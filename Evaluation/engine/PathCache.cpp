@@ -0,0 +1,89 @@
+#include "engine/PathCache.h"
+
+PathCache::PathCache(size_t capacity) : _capacity(capacity), _hits(0), _misses(0) {}
+
+bool PathCache::Key::operator==(const Key& other) const {
+	return from == other.from && to == other.to && blockedArcs == other.blockedArcs;
+}
+
+size_t PathCache::KeyHash::operator()(const Key& key) const {
+	size_t hash = std::hash<int>()(key.from) * 31 + std::hash<int>()(key.to);
+	for (int value : key.blockedArcs) {
+		hash = hash * 31 + std::hash<int>()(value);
+	}
+	return hash;
+}
+
+PathCache::Key PathCache::makeKey(int from, int to, const std::vector<std::pair<int, int>>& blockedArcs) const {
+	Key key;
+	key.from = from;
+	key.to = to;
+	key.blockedArcs.reserve(2 * blockedArcs.size());
+	for (const auto& arc : blockedArcs) {
+		key.blockedArcs.push_back(arc.first);
+		key.blockedArcs.push_back(arc.second);
+	}
+	return key;
+}
+
+bool PathCache::find(int from, int to, const std::vector<std::pair<int, int>>& blockedArcs, std::vector<int>& path) {
+	if (_capacity == 0) { return false; }
+
+	Key key = makeKey(from, to, blockedArcs);
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto it = _index.find(key);
+	if (it == _index.end()) {
+		++_misses;
+		return false;
+	}
+
+	++_hits;
+	_entries.splice(_entries.begin(), _entries, it->second);
+	path = it->second->second;
+	return true;
+}
+
+void PathCache::insert(int from, int to, const std::vector<std::pair<int, int>>& blockedArcs, const std::vector<int>& path) {
+	if (_capacity == 0) { return; }
+
+	Key key = makeKey(from, to, blockedArcs);
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto it = _index.find(key);
+	if (it != _index.end()) {
+		it->second->second = path;
+		_entries.splice(_entries.begin(), _entries, it->second);
+		return;
+	}
+
+	if (_entries.size() >= _capacity) {
+		_index.erase(_entries.back().first);
+		_entries.pop_back();
+	}
+	_entries.push_front(Entry(key, path));
+	_index[key] = _entries.begin();
+}
+
+void PathCache::clear() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	_entries.clear();
+	_index.clear();
+	_hits = 0;
+	_misses = 0;
+}
+
+size_t PathCache::getCapacity() const { return _capacity; }
+
+size_t PathCache::getSize() const {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _entries.size();
+}
+
+size_t PathCache::getHits() const {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _hits;
+}
+
+size_t PathCache::getMisses() const {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _misses;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Pami podrczna cieek w grafie nawigacji o ograniczonym rozmiarze. Po przekroczeniu
+// pojemnoci usuwana jest najdawniej uywana cieka. Moe by uywana przez wiele wtkw.
+class PathCache {
+public:
+	PathCache(size_t capacity);
+
+	// Ignorowane obszary s opisane posortowanym zbiorem ukw grafu nawigacji, ktre blokuj
+	// (pary wzw, mniejszy indeks pierwszy). Wynik wyszukiwania zaley wycznie od tego zbioru,
+	// wic cieka jest wsplna dla wszystkich obszarw blokujcych te same uki, np. kolejnych prb
+	// ominicia toku w tych samych drzwiach, mimo e rodki obszarw nigdy si nie powtarzaj.
+	// Zwraca true, jeeli cieka (rwnie pusta) znajduje si w pamici, i kopiuje j do path.
+	bool find(int from, int to, const std::vector<std::pair<int, int>>& blockedArcs, std::vector<int>& path);
+	void insert(int from, int to, const std::vector<std::pair<int, int>>& blockedArcs, const std::vector<int>& path);
+	void clear();
+
+	size_t getCapacity() const;
+	size_t getSize() const;
+	size_t getHits() const;
+	size_t getMisses() const;
+
+private:
+	struct Key {
+		int from;
+		int to;
+		// Kolejne pary wzw zablokowanych ukw.
+		std::vector<int> blockedArcs;
+
+		bool operator==(const Key& other) const;
+	};
+
+	struct KeyHash {
+		size_t operator()(const Key& key) const;
+	};
+
+	typedef std::pair<Key, std::vector<int>> Entry;
+
+	size_t _capacity;
+	std::list<Entry> _entries;
+	std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> _index;
+	size_t _hits;
+	size_t _misses;
+	mutable std::mutex _mutex;
+
+	Key makeKey(int from, int to, const std::vector<std::pair<int, int>>& blockedArcs) const;
+};
@@ -0,0 +1,106 @@
+#include "engine/PathService.h"
+#include "engine/Navigation.h"
+
+PathRequest::PathRequest(const Vector2& from, const Vector2& to, float radius, const std::vector<common::Circle>& ignoredAreas)
+	: _from(from), _to(to), _radius(radius), _ignoredAreas(ignoredAreas), _isCancelled(false) {
+	_result = _promise.get_future().share();
+}
+
+PathRequest::PathRequest(const Vector2& from, const Vector2& to, float radius, const common::Circle& blockedArea,
+	const std::shared_ptr<IncrementalPlanner>& planner)
+	: _from(from), _to(to), _radius(radius), _ignoredAreas({ blockedArea }), _planner(planner), _isCancelled(false) {
+	_result = _promise.get_future().share();
+}
+
+bool PathRequest::isReady() const {
+	return _result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+bool PathRequest::isCancelled() const { return _isCancelled; }
+
+void PathRequest::cancel() { _isCancelled = true; }
+
+const Path& PathRequest::getPath() const { return _result.get(); }
+
+PathService::PathService(const GameMap* map, size_t threadsCount) : _map(map), _isStopping(false) {
+	for (size_t i = 0; i < threadsCount; ++i) {
+		_threads.push_back(std::thread(&PathService::run, this));
+	}
+}
+
+PathService::~PathService() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_isStopping = true;
+	}
+	_condition.notify_all();
+	for (std::thread& thread : _threads) {
+		thread.join();
+	}
+
+	// Zlecenia, ktre nie zostay przetworzone, kocz si pust ciek.
+	for (auto& request : _requests) {
+		request->_promise.set_value(Path());
+	}
+}
+
+std::shared_ptr<PathRequest> PathService::request(const Vector2& from, const Vector2& to, float radius,
+	const std::vector<common::Circle>& ignoredAreas) {
+
+	auto request = std::make_shared<PathRequest>(from, to, radius, ignoredAreas);
+	enqueue(request);
+	return request;
+}
+
+std::shared_ptr<PathRequest> PathService::requestRepair(const Vector2& from, const Vector2& to, float radius,
+	const common::Circle& blockedArea, const std::shared_ptr<IncrementalPlanner>& planner) {
+
+	auto request = std::make_shared<PathRequest>(from, to, radius, blockedArea, planner);
+	enqueue(request);
+	return request;
+}
+
+void PathService::enqueue(const std::shared_ptr<PathRequest>& request) {
+	if (_threads.empty()) {
+		process(*request);
+	}
+	else {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_requests.push_back(request);
+		}
+		_condition.notify_one();
+	}
+}
+
+size_t PathService::getPendingCount() const {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _requests.size();
+}
+
+void PathService::run() {
+	while (true) {
+		std::shared_ptr<PathRequest> request;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_condition.wait(lock, [this]() { return _isStopping || !_requests.empty(); });
+			if (_isStopping) { return; }
+			request = _requests.front();
+			_requests.pop_front();
+		}
+		process(*request);
+	}
+}
+
+void PathService::process(PathRequest& request) {
+	if (request.isCancelled()) {
+		request._promise.set_value(Path());
+	}
+	else if (request._planner != nullptr) {
+		request._promise.set_value(_map->replan(*request._planner, request._from, request._to,
+			request._radius, request._ignoredAreas.front()));
+	}
+	else {
+		request._promise.set_value(_map->findPath(request._from, request._to, request._radius, request._ignoredAreas));
+	}
+}
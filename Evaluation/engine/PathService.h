@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+#include "math/Math.h"
+#include "engine/Path.h"
+
+class GameMap;
+class IncrementalPlanner;
+
+// Zlecenie wyznaczenia cieki. Wynik jest dostpny po jego przetworzeniu przez usug.
+class PathRequest {
+public:
+	PathRequest(const Vector2& from, const Vector2& to, float radius, const std::vector<common::Circle>& ignoredAreas);
+	// Zlecenie naprawy cieki przez planer obiektu po zablokowaniu obszaru blockedArea.
+	PathRequest(const Vector2& from, const Vector2& to, float radius, const common::Circle& blockedArea,
+		const std::shared_ptr<IncrementalPlanner>& planner);
+
+	bool isReady() const;
+	bool isCancelled() const;
+	// Anulowane zlecenie, ktre nie zostao jeszcze przetworzone, koczy si pust ciek.
+	void cancel();
+	// Czeka na wynik, jeeli nie jest jeszcze gotowy.
+	const Path& getPath() const;
+
+private:
+	Vector2 _from;
+	Vector2 _to;
+	float _radius;
+	std::vector<common::Circle> _ignoredAreas;
+	// Planer D* Lite obiektu (nullptr, jeeli cieka jest wyznaczana od nowa).
+	std::shared_ptr<IncrementalPlanner> _planner;
+	std::promise<Path> _promise;
+	std::shared_future<Path> _result;
+	std::atomic<bool> _isCancelled;
+
+	friend class PathService;
+};
+
+// Usuga planowania cieek z wasn pul wtkw i kolejk zlece, dziki ktrej wyszukiwanie
+// cieki nie wydua aktualizacji aktora. Przy zerowej liczbie wtkw zlecenia s
+// przetwarzane od razu, w wtku zlecajcym.
+class PathService {
+public:
+	PathService(const GameMap* map, size_t threadsCount);
+	~PathService();
+
+	// Zlecenie zawiera kopie wszystkich danych obiektu potrzebnych do wyznaczenia cieki,
+	// dziki czemu wtki usugi nie odwouj si do aktualizowanych rwnolegle obiektw gry.
+	std::shared_ptr<PathRequest> request(const Vector2& from, const Vector2& to, float radius,
+		const std::vector<common::Circle>& ignoredAreas = {});
+	// Planer naley do obiektu i jest wspdzielony ze zleceniem do czasu jego przetworzenia.
+	std::shared_ptr<PathRequest> requestRepair(const Vector2& from, const Vector2& to, float radius,
+		const common::Circle& blockedArea, const std::shared_ptr<IncrementalPlanner>& planner);
+
+	size_t getPendingCount() const;
+
+private:
+	const GameMap* _map;
+	std::vector<std::thread> _threads;
+	std::deque<std::shared_ptr<PathRequest>> _requests;
+	mutable std::mutex _mutex;
+	std::condition_variable _condition;
+	bool _isStopping;
+
+	void run();
+	void enqueue(const std::shared_ptr<PathRequest>& request);
+	void process(PathRequest& request);
+};
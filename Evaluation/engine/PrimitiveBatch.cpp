@@ -0,0 +1,94 @@
+#include "PrimitiveBatch.h"
+#include "Camera.h"
+
+PrimitiveBatch::PrimitiveBatch() : _batchesUsed(0) {}
+
+bool PrimitiveBatch::isEmpty() const { return _batchesUsed == 0; }
+
+PrimitiveBatch::ColorBatch& PrimitiveBatch::getBatch(const SDL_Color& color) {
+	for (size_t i = 0; i < _batchesUsed; ++i) {
+		const SDL_Color& other = _batches[i].color;
+		if (other.r == color.r && other.g == color.g && other.b == color.b && other.a == color.a) {
+			return _batches[i];
+		}
+	}
+	if (_batchesUsed == _batches.size()) {
+		_batches.push_back(ColorBatch());
+	}
+	ColorBatch& batch = _batches[_batchesUsed++];
+	batch.color = color;
+	return batch;
+}
+
+void PrimitiveBatch::addSpan(ColorBatch& batch, int x1, int x2, int y) {
+	batch.rects.push_back({ x1, y, x2 - x1 + 1, 1 });
+}
+
+void PrimitiveBatch::addSegment(const Segment& segment, const Camera& camera, const SDL_Color& color) {
+	ColorBatch& batch = getBatch(color);
+	int x = camera.getX(), y = camera.getY();
+	SDL_Point from = { int(segment.from.x) - x, int(segment.from.y) - y };
+	SDL_Point to = { int(segment.to.x) - x, int(segment.to.y) - y };
+
+	if (!batch.lineLengths.empty() && batch.points.back().x == from.x && batch.points.back().y == from.y) {
+		batch.points.push_back(to);
+		++batch.lineLengths.back();
+	}
+	else {
+		batch.points.push_back(from);
+		batch.points.push_back(to);
+		batch.lineLengths.push_back(2);
+	}
+}
+
+void PrimitiveBatch::addPoint(const Vector2& point, const Camera& camera, const SDL_Color& color) {
+	SDL_Rect rect = { int(point.x - 2), int(point.y - 2), 5, 5 };
+	camera.adjustRenderArea(rect);
+	getBatch(color).rects.push_back(rect);
+}
+
+void PrimitiveBatch::addCircle(const Vector2& center, float radius, const Camera& camera, const SDL_Color& color) {
+	ColorBatch& batch = getBatch(color);
+	int x = int(center.x) - camera.getX(), y = int(center.y) - camera.getY(), r = int(radius), r2 = r * r;
+	for (int i = -r; i <= r; ++i) {
+		int t = sqrt(r2 - i * i);
+		addSpan(batch, x - t, x + t, y + i);
+	}
+}
+
+void PrimitiveBatch::addRing(const Vector2& center, float radius1, float radius2, const Camera& camera, const SDL_Color& color) {
+	if (radius1 > radius2) { common::swap(radius1, radius2); }
+	ColorBatch& batch = getBatch(color);
+	int x = int(center.x) - camera.getX(), y = int(center.y) - camera.getY(), r1 = int(radius1), r12 = r1 * r1, r2 = int(radius2), r22 = r2 * r2;
+	for (int i = -r2; i <= r2; ++i) {
+		if (-r1 <= i && i <= r1) {
+			int t1 = sqrt(r12 - i * i);
+			int t2 = sqrt(r22 - i * i);
+			addSpan(batch, x - t2, x - t1, y + i);
+			addSpan(batch, x + t1, x + t2, y + i);
+		}
+		else {
+			int t = sqrt(r22 - i * i);
+			addSpan(batch, x - t, x + t, y + i);
+		}
+	}
+}
+
+void PrimitiveBatch::flush(SDL_Renderer* renderer) {
+	for (size_t i = 0; i < _batchesUsed; ++i) {
+		ColorBatch& batch = _batches[i];
+		SDL_SetRenderDrawColor(renderer, batch.color.r, batch.color.g, batch.color.b, batch.color.a);
+		if (!batch.rects.empty()) {
+			SDL_RenderFillRects(renderer, batch.rects.data(), batch.rects.size());
+		}
+		const SDL_Point* line = batch.points.data();
+		for (int length : batch.lineLengths) {
+			SDL_RenderDrawLines(renderer, line, length);
+			line += length;
+		}
+		batch.rects.clear();
+		batch.points.clear();
+		batch.lineLengths.clear();
+	}
+	_batchesUsed = 0;
+}
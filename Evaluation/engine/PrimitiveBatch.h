@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vector>
+#include "SDL.h"
+#include "math/Math.h"
+
+class Camera;
+
+// Gromadzi prymitywy rysowane w jednej warstwie klatki i przekazuje je do renderera
+// w kilku wywoaniach: wszystkie wypenione obszary w danym kolorze trafiaj do jednego
+// SDL_RenderFillRects, a kolejne stykajce si odcinki czone s w amane dla SDL_RenderDrawLines.
+// Prymitywy s grupowane wedug koloru, wic kolejno rysowania w obrbie warstwy nie jest zachowana.
+class PrimitiveBatch {
+public:
+	PrimitiveBatch();
+
+	bool isEmpty() const;
+
+	void addSegment(const Segment& segment, const Camera& camera, const SDL_Color& color);
+	void addPoint(const Vector2& point, const Camera& camera, const SDL_Color& color);
+	void addCircle(const Vector2& center, float radius, const Camera& camera, const SDL_Color& color);
+	void addRing(const Vector2& center, float radius1, float radius2, const Camera& camera, const SDL_Color& color);
+
+	// Rysuje zgromadzone prymitywy i oprnia bufory, zachowujc przydzielon pami.
+	void flush(SDL_Renderer* renderer);
+
+private:
+	struct ColorBatch {
+		SDL_Color color;
+		std::vector<SDL_Rect> rects;
+		std::vector<SDL_Point> points;
+		std::vector<int> lineLengths;
+	};
+
+	std::vector<ColorBatch> _batches;
+	size_t _batchesUsed;
+
+	ColorBatch& getBatch(const SDL_Color& color);
+	static void addSpan(ColorBatch& batch, int x1, int x2, int y);
+};
@@ -5,12 +5,13 @@
 
 ResourceManager* ResourceManager::_instance = nullptr;
 
-ResourceManager::ResourceManager() {}
+ResourceManager::ResourceManager() : _texturesRenderer(nullptr) {}
 
 ResourceManager* ResourceManager::get() { return _instance; }
 
 ResourceManager::~ResourceManager() {
-	for (auto it = _textures.begin(); it != _textures.end(); ++it) {
+	clearTextures();
+	for (auto it = _images.begin(); it != _images.end(); ++it) {
 		SDL_FreeSurface(it->second);
 	}
 	for (auto it = _fonts.begin(); it != _fonts.end(); ++it) {
@@ -23,12 +24,12 @@ void ResourceManager::loadImage(const std::string& key, const std::string& filen
 		if (hasImage(key)) { throw "Klucz " + key + " juz zostal przypisany.";  }
 		SDL_Surface* surface = IMG_Load(filename.c_str());
 		if (surface != nullptr) {
-			_textures.insert({ key, surface });
+			_images.insert({ key, surface });
 		}
 		else { throw SDL_GetError(); }
 	}
 	catch (const char* s) {
-		Logger::log("Blad podczas wczytywania pliku '" + filename + "': " + s + ".");
+		LOG(LOG_ERROR, LOG_RESOURCES, "Blad podczas wczytywania pliku '" + filename + "': " + s + ".");
 	}
 }
 
@@ -46,13 +47,80 @@ void ResourceManager::loadFont(const std::string& key, const std::string& filena
 	}
 }
 
-bool ResourceManager::hasImage(const std::string& key) const { return _textures.find(key) != _textures.end(); }
+bool ResourceManager::hasImage(const std::string& key) const { return _images.find(key) != _images.end(); }
 
 bool ResourceManager::hasFont(const std::string& key) const { return _fonts.find(key) != _fonts.end(); }
 
 SDL_Surface* ResourceManager::getImage(const std::string& key) const {
+	auto result = _images.find(key);
+	return result != _images.end() ? result->second : nullptr;
+}
+
+SDL_Texture* ResourceManager::getTexture(SDL_Renderer* renderer, const std::string& key) {
+	useRenderer(renderer);
 	auto result = _textures.find(key);
-	return result != _textures.end() ? result->second : nullptr;
+	if (result != _textures.end()) { return result->second; }
+
+	SDL_Surface* surface = getImage(key);
+	SDL_Texture* texture = surface != nullptr ? SDL_CreateTextureFromSurface(renderer, surface) : nullptr;
+	if (texture != nullptr) {
+		_textures.insert({ key, texture });
+	}
+	return texture;
+}
+
+const GlyphAtlas* ResourceManager::getGlyphAtlas(SDL_Renderer* renderer, const std::string& fontKey) {
+	useRenderer(renderer);
+	auto result = _glyphAtlases.find(fontKey);
+	if (result != _glyphAtlases.end()) { return result->second.get(); }
+
+	TTF_Font* font = getFont(fontKey);
+	if (font == nullptr) { return nullptr; }
+	GlyphAtlas* atlas = new GlyphAtlas(renderer, font);
+	_glyphAtlases.insert({ fontKey, std::unique_ptr<GlyphAtlas>(atlas) });
+	return atlas;
+}
+
+SDL_Texture* ResourceManager::getLabel(SDL_Renderer* renderer, const std::string& fontKey, const std::string& text) {
+	useRenderer(renderer);
+	std::string key = fontKey + '\n' + text;
+	auto result = _labels.find(key);
+	if (result != _labels.end()) { return result->second; }
+
+	TTF_Font* font = getFont(fontKey);
+	if (font == nullptr || text.empty()) { return nullptr; }
+	SDL_Surface* surface = TTF_RenderText_Blended(font, text.c_str(), { 255, 255, 255, 255 });
+	if (surface == nullptr) { return nullptr; }
+	SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+	SDL_FreeSurface(surface);
+	if (texture != nullptr) {
+		if (_labels.size() >= MAX_LABELS) { clearLabels(); }
+		_labels.insert({ key, texture });
+	}
+	return texture;
+}
+
+void ResourceManager::useRenderer(SDL_Renderer* renderer) {
+	if (renderer != _texturesRenderer) {
+		clearTextures();
+		_texturesRenderer = renderer;
+	}
+}
+
+void ResourceManager::clearTextures() {
+	for (auto it = _textures.begin(); it != _textures.end(); ++it) {
+		SDL_DestroyTexture(it->second);
+	}
+	_textures.clear();
+	_glyphAtlases.clear();
+	clearLabels();
+}
+
+void ResourceManager::clearLabels() {
+	for (auto it = _labels.begin(); it != _labels.end(); ++it) {
+		SDL_DestroyTexture(it->second);
+	}
+	_labels.clear();
 }
 
 TTF_Font* ResourceManager::getFont(const std::string& key) const {
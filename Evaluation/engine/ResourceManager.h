@@ -1,29 +1,49 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <SDL.h>
 #include <SDL_ttf.h>
+#include "GlyphAtlas.h"
 
 class ResourceManager {
 public:
 	void loadImage(const std::string& key, const std::string& filename);
 	bool hasImage(const std::string& key) const;
 	SDL_Surface* getImage(const std::string& key) const;
+	// Zwraca tekstur utworzon z obrazu o podanym kluczu. Tekstura jest tworzona przy pierwszym
+	// uyciu i przechowywana do zwolnienia zasobw lub zmiany renderera.
+	SDL_Texture* getTexture(SDL_Renderer* renderer, const std::string& key);
 	
 	void loadFont(const std::string& key, const std::string& filename, int size);
 	bool hasFont(const std::string& key) const;
 	TTF_Font* getFont(const std::string& key) const;
+	// Zwraca atlas znakw czcionki o podanym kluczu, tworzc go przy pierwszym uyciu.
+	const GlyphAtlas* getGlyphAtlas(SDL_Renderer* renderer, const std::string& fontKey);
+	// Zwraca bia tekstur z napisem. Tekstury napisw s przechowywane, dopki ich liczba
+	// nie przekroczy MAX_LABELS, wic nadaj si do napisw zmieniajcych si rzadko, np. nazw aktorw.
+	SDL_Texture* getLabel(SDL_Renderer* renderer, const std::string& fontKey, const std::string& text);
 
 	static bool initialize();
 	static void dispose();
 	static ResourceManager* get();
 
 private:
-	std::unordered_map<std::string, SDL_Surface*> _textures;
+	std::unordered_map<std::string, SDL_Surface*> _images;
+	std::unordered_map<std::string, SDL_Texture*> _textures;
+	std::unordered_map<std::string, std::unique_ptr<GlyphAtlas>> _glyphAtlases;
+	std::unordered_map<std::string, SDL_Texture*> _labels;
+	SDL_Renderer* _texturesRenderer;
+
+	static const size_t MAX_LABELS = 512;
 	std::unordered_map<std::string, TTF_Font*> _fonts;
 
 	ResourceManager();
+
+	void useRenderer(SDL_Renderer* renderer);
+	void clearTextures();
+	void clearLabels();
 	~ResourceManager();
 
 	static ResourceManager* _instance;
@@ -0,0 +1,75 @@
+#include "WorkerPool.h"
+#include <algorithm>
+
+WorkerPool::WorkerPool(size_t threadsCount)
+	: _itemsCount(0), _batchSize(1), _nextItem(0), _activeWorkers(0), _generation(0), _isStopping(false) {
+	for (size_t i = 0; i < threadsCount; ++i) {
+		_threads.push_back(std::thread(&WorkerPool::runWorker, this, i + 1));
+	}
+}
+
+WorkerPool::~WorkerPool() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_isStopping = true;
+	}
+	_startCondition.notify_all();
+	for (std::thread& thread : _threads) {
+		thread.join();
+	}
+}
+
+size_t WorkerPool::getConcurrency() const { return _threads.size() + 1; }
+
+void WorkerPool::parallelFor(size_t count, size_t batchSize, const std::function<void(size_t, size_t)>& task) {
+	if (_threads.empty() || count <= batchSize) {
+		for (size_t i = 0; i < count; ++i) {
+			task(i, 0);
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_task = task;
+		_itemsCount = count;
+		_batchSize = batchSize;
+		_nextItem = 0;
+		_activeWorkers = _threads.size();
+		++_generation;
+	}
+	_startCondition.notify_all();
+	runBatches(0);
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	_doneCondition.wait(lock, [this] { return _activeWorkers == 0; });
+}
+
+void WorkerPool::runBatches(size_t worker) {
+	size_t from;
+	while ((from = _nextItem.fetch_add(_batchSize)) < _itemsCount) {
+		size_t to = std::min(from + _batchSize, _itemsCount);
+		for (size_t i = from; i < to; ++i) {
+			_task(i, worker);
+		}
+	}
+}
+
+void WorkerPool::runWorker(size_t worker) {
+	unsigned int generation = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_startCondition.wait(lock, [&] { return _isStopping || _generation != generation; });
+			if (_isStopping) { return; }
+			generation = _generation;
+		}
+		runBatches(worker);
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (--_activeWorkers == 0) {
+				_doneCondition.notify_one();
+			}
+		}
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Staa pula wtkw wykonujcych ptle rwnolege. Wtek wywoujcy parallelFor rwnie przetwarza
+// elementy i wraca dopiero po zakoczeniu wszystkich paczek.
+class WorkerPool {
+public:
+	WorkerPool(size_t threadsCount);
+	~WorkerPool();
+
+	// Liczba wtkw, ktre mog jednoczenie wykonywa zadanie (wraz z wtkiem wywoujcym).
+	size_t getConcurrency() const;
+
+	// Wykonuje task(i, worker) dla i = 0..count-1 w paczkach po batchSize elementw.
+	// worker to numer wtku z przedziau [0, getConcurrency()), 0 dla wtku wywoujcego.
+	void parallelFor(size_t count, size_t batchSize, const std::function<void(size_t, size_t)>& task);
+
+private:
+	std::vector<std::thread> _threads;
+	std::mutex _mutex;
+	std::condition_variable _startCondition;
+	std::condition_variable _doneCondition;
+	std::function<void(size_t, size_t)> _task;
+	size_t _itemsCount;
+	size_t _batchSize;
+	std::atomic<size_t> _nextItem;
+	size_t _activeWorkers;
+	unsigned int _generation;
+	bool _isStopping;
+
+	void runBatches(size_t worker);
+	void runWorker(size_t worker);
+};
@@ -8,30 +8,49 @@
 #include "main/Game.h"
 #include "entities/Wall.h"
 #include "actions/Die.h"
+#include <algorithm>
+#include <limits>
 
 Actor::Actor(const String& name, const Vector2& position)
-	: Movable(position) {
+	: Movable(position), _isDeathPending(false) {
 	_name = name;
 	_health = common::min(Config.ActorMaxHealth, Config.ActorMaxHealth * Config.ActorInitialHealth);
 	_armor = 0;
 	_armorShotsRemaining = 0;	
+	_currentAction = nullptr;
+	_nextAction = nullptr;
+	for (ActionSlot& slot : _actionSlots) {
+		slot.isUsed = false;
+	}
+
 	_currentWeapon = Config.DefaultWeapon;
+	_currentWeaponId = MissileManager::getWeaponId(Config.DefaultWeapon);
+	_nextReloadTime = std::numeric_limits<GameTime>::max();
 
-	for (auto entry : MissileManager::getWeaponsInfo()) {
-		WeaponState weaponState;
+	const std::map<String, WeaponInfo>& weaponsInfo = MissileManager::getWeaponsInfo();
+	_weapons.resize(weaponsInfo.size());
+	for (const auto& entry : weaponsInfo) {
+		WeaponState& weaponState = _weapons[entry.second.id];
 		weaponState.lastShot = 0;
+		weaponState.readyTime = 0;
 		weaponState.state = WeaponLoadState::WEAPON_LOADED;
 		weaponState.ammo = entry.second.initialAmmo;
-		_weapons[entry.first] = weaponState;
 	}
 }
 
-Actor::~Actor() { }
+Actor::~Actor() {
+	clearCurrentAction();
+	if (_nextAction != nullptr) {
+		releaseAction(_nextAction);
+	}
+}
 
 float Actor::getHealth() const { return _health; }
 
 String Actor::getCurrentWeapon() const { return _currentWeapon; }
 
+int Actor::getCurrentWeaponId() const { return _currentWeaponId; }
+
 String Actor::getName() const { return _name; }
 
 Team* Actor::getTeam() const { return _team; }
@@ -42,7 +61,7 @@ int Actor::getRemainingArmorShots() const { return _armorShotsRemaining; }
 
 bool Actor::isDead() const { return getCurrentActionType() == ActionType::DEAD; }
 
-void Actor::setAmmo(const String& weaponName, int value) { _weapons[weaponName].ammo = value; }
+void Actor::setAmmo(int weaponId, int value) { _weapons[weaponId].ammo = value; }
 
 void Actor::setArmor(float value) { _armor = value; }
 
@@ -52,32 +71,33 @@ Action* Actor::getCurrentAction() const { return _currentAction; }
 
 void Actor::clearCurrentAction() {
 	if (_currentAction != nullptr) {
-		delete _currentAction; 
+		releaseAction(_currentAction);
 		_currentAction = nullptr;
 	}
 }
 
-bool Actor::setCurrentAction(Action* action) {
-	if (_currentAction != nullptr) {
-		if (action->getActionType() == ActionType::DIE || !_currentAction->isTransactional()) {
-			_currentAction->finish(0);
-			delete _currentAction;
-			_currentAction = action;
-			return true;
+bool Actor::canInterruptCurrentAction() const {
+	return _currentAction == nullptr || !_currentAction->isTransactional();
+}
+
+void* Actor::acquireActionSlot() {
+	for (ActionSlot& slot : _actionSlots) {
+		if (!slot.isUsed) {
+			slot.isUsed = true;
+			return &slot.storage;
 		}
-		return false;
 	}
-	else {
-		_currentAction = action;
-		return true;
-	}	
+	return nullptr;
 }
 
-void Actor::setNextAction(Action* action) {
-	if (_nextAction != nullptr) {
-		delete _nextAction;
+void Actor::releaseAction(Action* action) {
+	void* address = dynamic_cast<void*>(action);
+	action->~Action();
+	for (ActionSlot& slot : _actionSlots) {
+		if (&slot.storage == address) {
+			slot.isUsed = false;
+		}
 	}
-	_nextAction = action;
 }
 
 float Actor::heal(float health) {
@@ -89,7 +109,7 @@ float Actor::heal(float health) {
 	else {
 		_health += health;
 	}
-	Logger::log("Actor " + _name + " restores " + std::to_string(health) + " health.");
+	LOG(LOG_INFO, LOG_COMBAT, "Actor " + _name + " restores " + std::to_string(health) + " health.");
 	return health;
 }
 
@@ -106,16 +126,25 @@ void Actor::registerKill(const Destructible* destructible) {
 	}
 }
 
-void Actor::setCurrentWeapon(const String& weaponName) {
-	if (_currentWeapon != weaponName) {
-		_currentWeapon = weaponName;
-		Logger::log("Actor " + _name + " changed weapon to " + weaponName + ".");
+void Actor::setCurrentWeapon(int weaponId) {
+	if (_currentWeaponId != weaponId) {
+		_currentWeaponId = weaponId;
+		_currentWeapon = MissileManager::getWeaponInfo(weaponId).name;
+		LOG(LOG_INFO, LOG_COMBAT, "Actor " + _name + " changed weapon to " + _currentWeapon + ".");
 	}
 }
 
-WeaponState& Actor::getWeaponState(const String& weaponName) { return _weapons[weaponName]; }
+WeaponState& Actor::getWeaponState(int weaponId) { return _weapons[weaponId]; }
+
+const WeaponState& Actor::getWeaponState(int weaponId) const { return _weapons[weaponId]; }
 
-const WeaponState& Actor::getWeaponState(const String& weaponName) const { return _weapons.at(weaponName); }
+void Actor::unloadWeapon(int weaponId, GameTime time) {
+	WeaponState& weaponState = _weapons[weaponId];
+	weaponState.state = WeaponLoadState::WEAPON_UNLOADED;
+	weaponState.lastShot = time;
+	weaponState.readyTime = time + MissileManager::getWeaponInfo(weaponId).reloadTime;
+	_nextReloadTime = std::min(_nextReloadTime, weaponState.readyTime);
+}
 
 bool Actor::updateCurrentAction(GameTime time) {
 	if (_currentAction != nullptr) {
@@ -140,6 +169,10 @@ bool Actor::isLookingStraight() const {
 }
 
 void Actor::update(GameTime time) {	
+	if (_isDeathPending.exchange(false)) {
+		setCurrentAction<DieAction>();
+	}
+
 #ifdef _DEBUG	
 	GameTime from, to;
 	bool logIfSuccessful;
@@ -148,14 +181,14 @@ void Actor::update(GameTime time) {
 	logIfSuccessful = updateWeapons(time);
 	to = SDL_GetPerformanceCounter();
 	if (logIfSuccessful) {
-		Logger::logIfNotIgnored("updateWeapons", "Update Weapons:         " + std::to_string(to - from));
+		LOG(LOG_DEBUG, LOG_PERFORMANCE, "Update Weapons:         " + std::to_string(to - from));
 	}
 
 	from = SDL_GetPerformanceCounter();
 	logIfSuccessful = updateCurrentAction(time);
 	to = SDL_GetPerformanceCounter();
 	if (logIfSuccessful) {
-		Logger::logIfNotIgnored("updateCurrentAction", "Update Current Action:  " + std::to_string(to - from));
+		LOG(LOG_DEBUG, LOG_PERFORMANCE, "Update Current Action:  " + std::to_string(to - from));
 	}
 #else
 	updateWeapons(time);
@@ -168,14 +201,20 @@ void Actor::update(GameTime time) {
 }
 
 bool Actor::updateWeapons(GameTime time) {
+	// Dopki adna bro nie jest gotowa do zaadowania, nie trzeba przeglda tablicy.
+	if (time <= _nextReloadTime) { return false; }
+
 	bool wasAntyhingUpdated = false;
-	for (auto entry : MissileManager::getWeaponsInfo()) {
-		const String& weaponName = entry.first;
-		if (_weapons[weaponName].state == WeaponLoadState::WEAPON_UNLOADED
-			&& time - _weapons[weaponName].lastShot
-			> entry.second.reloadTime) {
-			_weapons[weaponName].state = WeaponLoadState::WEAPON_LOADED;
-			wasAntyhingUpdated = true;
+	_nextReloadTime = std::numeric_limits<GameTime>::max();
+	for (WeaponState& weaponState : _weapons) {
+		if (weaponState.state == WeaponLoadState::WEAPON_UNLOADED) {
+			if (time > weaponState.readyTime) {
+				weaponState.state = WeaponLoadState::WEAPON_LOADED;
+				wasAntyhingUpdated = true;
+			}
+			else {
+				_nextReloadTime = std::min(_nextReloadTime, weaponState.readyTime);
+			}
 		}
 	}
 	return wasAntyhingUpdated;
@@ -217,7 +256,7 @@ float Actor::recieveDamage(float dmg) {
 		dmg = _health;
 		_health = 0;
 	}
-	Logger::log("Actor " + _name + " receives " + std::to_string(dmg) + " damage.");
+	LOG(LOG_INFO, LOG_COMBAT, "Actor " + _name + " receives " + std::to_string(dmg) + " damage.");
 	return dmg;
 }
 
@@ -231,10 +270,15 @@ bool Actor::wasDestroyed() const {
 
 
 void Actor::onDestroy() {
-	// to do
-	setCurrentAction(new DieAction(this));
+	// Aktor aktualizowany we wasnym wtku moe wanie zmienia akcj, wic akcja umierania
+	// zostanie rozpoczta przy jego najbliszej aktualizacji.
+	if (Config.MultithreadingEnabled) {
+		_isDeathPending = true;
+	}
+	else {
+		setCurrentAction<DieAction>();
+	}
 	_isDestroyed = true;
-	//throw;
 }
 
 float Actor::getSquareDistanceTo(const Vector2& point) const {
@@ -7,10 +7,16 @@
 #include "entities/Team.h"
 #include "engine/Logger.h"
 #include "actions/Action.h"
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 class MissileManager;
 class Team;
 class Action;
+class DieAction;
 class Trigger;
 class Wall;
 class Game;
@@ -34,15 +40,24 @@ public:
 	void setRemainingArmorShots(int value);
 
 	// Waciwoci dotyczce broni
-	void setAmmo(const String& weaponName, int value);
-	WeaponState& getWeaponState(const String& weaponName);
-	const WeaponState& getWeaponState(const String& weaponName) const;
+	// Bro identyfikowana jest indeksem nadanym przez MissileManager::getWeaponId.
+	void setAmmo(int weaponId, int value);
+	WeaponState& getWeaponState(int weaponId);
+	const WeaponState& getWeaponState(int weaponId) const;
+	// Oznacza bro jako rozadowan; zostanie zaadowana po upywie WeaponInfo::reloadTime.
+	void unloadWeapon(int weaponId, GameTime time);
 	
 	// Waciwoci dotyczce akcji
 	Action* getCurrentAction() const;
 	ActionType getCurrentActionType() const;
-	bool setCurrentAction(Action* action);
-	void setNextAction(Action* action);
+	// Akcje tworzone s w miejscach zarezerwowanych wewntrz obiektu aktora, bez alokacji na stercie.
+	// Miejsca nie s chronione przed dostpem z wielu wtkw, dlatego akcje zmieniane s wycznie
+	// w wtku aktualizujcym aktora (mier zgoszona z innego wtku obsuguje Actor::update).
+	// Zwraca false bez tworzenia akcji, jeeli biecej akcji nie mona przerwa, aktor oczekuje
+	// na rozpoczcie akcji umierania lub brak wolnego miejsca.
+	template <typename T, typename... Args> bool setCurrentAction(Args&&... args);
+	template <typename T, typename... Args> void setNextAction(Args&&... args);
+	bool canInterruptCurrentAction() const;
 	
 	// Waciwoci dotyczce zaobserwowanych obiektw
 	std::vector<Actor*> getSeenActors() const;
@@ -59,6 +74,7 @@ public:
 
 	// Interfejs MissileOwner
 	String getCurrentWeapon() const override;
+	int getCurrentWeaponId() const override;
 	void registerKill(const Destructible* destructible) override;
 	
 	// Interfejs Destructible
@@ -81,16 +97,36 @@ private:
 	float _armor;
 	int _armorShotsRemaining;
 	String _currentWeapon;
-	std::map<String, WeaponState> _weapons;
+	int _currentWeaponId;
+	std::vector<WeaponState> _weapons;
+	// Najwczeniejsza chwila zaadowania jednej z rozadowanych broni.
+	GameTime _nextReloadTime;
 
 	int _kills;
 	int _friendkills;
 	bool _isDestroyed = false;
+	// Ustawiana przez onDestroy, gdy aktor jest aktualizowany we wasnym wtku.
+	std::atomic<bool> _isDeathPending;
 
 	Action* _currentAction;
 	Action* _nextAction;
 
-	void setCurrentWeapon(const String& weaponName);
+	// Jednoczenie istniej co najwyej: bieca akcja, akcja zastpujca j oraz akcja nastpna.
+	static const size_t ACTION_SLOTS_COUNT = 3;
+	static const size_t ACTION_SLOT_SIZE = 64;
+
+	struct ActionSlot {
+		std::aligned_storage<ACTION_SLOT_SIZE, alignof(std::max_align_t)>::type storage;
+		bool isUsed;
+	};
+
+	ActionSlot _actionSlots[ACTION_SLOTS_COUNT];
+
+	// Zwraca nullptr, jeeli wszystkie miejsca s zajte.
+	void* acquireActionSlot();
+	void releaseAction(Action* action);
+
+	void setCurrentWeapon(int weaponId);
 	void clearCurrentAction();	
 
 	bool updateWeapons(GameTime time);
@@ -106,3 +142,31 @@ private:
 	friend class IdleAction;
 	friend class DeadAction;
 };
+
+template <typename T, typename... Args> bool Actor::setCurrentAction(Args&&... args) {
+	static_assert(sizeof(T) <= ACTION_SLOT_SIZE, "Action does not fit in an action slot.");
+	if (!std::is_same<T, DieAction>::value && (_isDeathPending || !canInterruptCurrentAction())) {
+		return false;
+	}
+	void* slot = acquireActionSlot();
+	if (slot == nullptr) { return false; }
+	Action* action = new (slot) T(this, std::forward<Args>(args)...);
+	if (_currentAction != nullptr) {
+		_currentAction->finish(0);
+		releaseAction(_currentAction);
+	}
+	_currentAction = action;
+	return true;
+}
+
+template <typename T, typename... Args> void Actor::setNextAction(Args&&... args) {
+	static_assert(sizeof(T) <= ACTION_SLOT_SIZE, "Action does not fit in an action slot.");
+	if (_nextAction != nullptr) {
+		releaseAction(_nextAction);
+		_nextAction = nullptr;
+	}
+	void* slot = acquireActionSlot();
+	if (slot != nullptr) {
+		_nextAction = new (slot) T(this, std::forward<Args>(args)...);
+	}
+}
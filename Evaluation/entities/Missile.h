@@ -10,19 +10,14 @@ class MissileOwner {
 public:	
 	virtual Vector2 getPosition() const = 0;
 	virtual String getCurrentWeapon() const = 0;
+	virtual int getCurrentWeaponId() const = 0;
 	virtual void registerKill(const Destructible* destructible) = 0;
 };
 
+// Widoczny odcinek pocisku. Stan lotu pociskw przechowuje MissileManager.
 class Missile : public Entity {
 public:
-	MissileOwner* owner;
-	Vector2 origin;
-	Vector2 target;
-	String weaponType;
-	GameTime timeFired;
-	GameTime timeHit;
-	bool isActive;
-	bool isTargetReached;
 	Vector2 frontPosition;
 	Vector2 backPosition;
+	int weaponId;
 };
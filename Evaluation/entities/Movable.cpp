@@ -5,6 +5,15 @@
 #include "main/Game.h"
 #include "entities/Wall.h"
 #include "engine/CommonFunctions.h"
+#include "engine/PathService.h"
+#include "engine/IncrementalPlanner.h"
+#include "engine/FlowField.h"
+#include "engine/Orca.h"
+#include <limits>
+#ifdef _DEBUG
+#include <iostream>
+#include "engine/Rng.h"
+#endif
 
 
 Vector2 Movable::getPosition() const { return DynamicEntity::getPosition(); }
@@ -26,6 +35,7 @@ Movable::Movable(const Vector2& position)
 	_isRotating = false;
 	_isWaiting = false;
 	_recalculations = 0;
+	_viewConeOrientation = std::numeric_limits<float>::quiet_NaN();
 	_positionHistoryLength = 0;
 	_nextHistoryIdx = 0;
 
@@ -34,7 +44,7 @@ Movable::Movable(const Vector2& position)
 	}
 }
 
-std::queue<Vector2> Movable::getCurrentPath() const { return _path; }
+const Path& Movable::getCurrentPath() const { return _path; }
 
 void Movable::setPreferredVelocity(const Vector2& velocity) { _preferredVelocity = velocity; }
 
@@ -45,23 +55,11 @@ Vector2 Movable::getVelocity() const { return _velocity; }
 
 Vector2 Movable::getShortGoal() const { return _nextSafeGoal; }
 
-Vector2 Movable::getLongGoal() const { return _path.empty() ? _position : _path.back(); }
+Vector2 Movable::getLongGoal() const { return _path.isEmpty() ? _position : _path.getGoal(); }
 
 float Movable::estimateRemainingDistance() const {
-	auto path = this->getCurrentPath();
-	float distance = 0;
-	if (!path.empty()) {
-		Vector2 last = path.front();
-		path.pop();
-		Vector2 next;
-		while (!path.empty()) {
-			next = path.front();
-			path.pop();
-			distance += common::distance(last, next);
-			next = last;
-		}
-	}
-	return distance;
+	if (_path.isEmpty()) { return 0; }
+	return common::distance(_position, _path.getNext()) + _path.getRemainingLength();
 }
 
 bool Movable::hasPositionChanged() const { return _velocity.lengthSquared() > common::EPSILON; }
@@ -98,7 +96,7 @@ MovementCheckResult Movable::checkMovement() const {
 	if (checkMovementCollisions(getCollisionResolver(), this, Segment(_position, futurePosition))) {
 		//_path.size() > 0 ? ActorRadius - MovementSafetyMargin : ActorRadius)) {
 		result.allowed = false;
-		//Logger::log("Actor " + _name + " movement wasn't allowed.");
+		//LOG(LOG_DEBUG, LOG_ACTIONS, "Actor " + _name + " movement wasn't allowed.");
 	}
 
 	return result;
@@ -234,6 +232,36 @@ std::vector<VelocityObstacle> Movable::getVelocityObstacles(const std::vector<Sp
 	return result;
 }
 
+// Ograniczenia ORCA wyznaczane przez wtek agenta (bufor wielokrotnego uytku).
+thread_local std::vector<OrcaLine> orcaLines;
+
+Vector2 Movable::computeOrcaVelocity() const {
+	std::vector<OrcaLine>& lines = orcaLines;
+	lines.clear();
+
+	float r = getRadius();
+	float speed = getMaxSpeed();
+
+	computeObstacleLines(getCollisionResolver(), _position, r + Config.MovementSafetyMargin, speed, lines);
+	size_t obstacleLines = lines.size();
+
+	// Obiekty nieporuszajce si nie unikaj kolizji, wic caa zmiana prdkoci przypada na ten obiekt.
+	float neighborRange = Config.ActorVOCheckRadius;
+	for (Spottable* other : getSpottedObjects()) {
+		if (other == this || !other->isSolid()) { continue; }
+		Vector2 relativePosition = other->getPosition() - _position;
+		float combinedRadius = r + other->getRadius() + common::EPSILON;
+		if (relativePosition.lengthSquared() > common::sqr(neighborRange + combinedRadius)) { continue; }
+
+		const Movable* movable = dynamic_cast<const Movable*>(other);
+		Vector2 otherVelocity = movable != nullptr ? movable->getVelocity() : Vector2();
+		lines.push_back(computeOrcaLine(relativePosition, _velocity, otherVelocity,
+			combinedRadius, Config.OrcaTimeHorizon, movable != nullptr && movable->isMoving() ? 0.5f : 1.0f));
+	}
+
+	return solveOrcaProgram(lines, obstacleLines, speed, _preferredVelocity);
+}
+
 void Movable::lookAt(const Vector2& point) {
 	_desiredOrientation = common::angleFromTo(_position, point);
 	_isRotating = true;
@@ -241,9 +269,9 @@ void Movable::lookAt(const Vector2& point) {
 
 std::vector<Segment> Movable::getSegmentsNearGoal() const {
 	std::vector<Segment> result;
-	if (!_path.empty()) {
+	if (!_path.isEmpty()) {
 		float dist = (1.1f * getRadius() + common::EPSILON) * common::SQRT_2_F;
-		Vector2 point = _path.front();
+		Vector2 point = _path.getNext();
 
 		auto broadphaseResult = getCollisionResolver()->broadphaseStatic(point, dist);
 		
@@ -259,7 +287,7 @@ std::vector<Segment> Movable::getSegmentsNearGoal() const {
 }
 
 Vector2 Movable::getNextSafeGoal() const {
-	if (!_path.empty()) {
+	if (!_path.isEmpty()) {
 		auto walls = getSegmentsNearGoal();
 		if (walls.size() == 2) {
 			Vector2 p11 = walls.at(0).from,
@@ -331,21 +359,22 @@ Vector2 Movable::getNextSafeGoal() const {
 					* (Config.ActorRadius + Config.MovementSafetyMargin + common::EPSILON);
 			}
 		}
-		return _path.front();
+		return _path.getNext();
 	}
 	return _position;
 }
 
 float Movable::getDistanceToGoal() const {
-	if (_path.empty()) { return 0; }
+	if (_path.isEmpty()) { return 0; }
 	return (_position - _nextSafeGoal).length();
 }
 
-void Movable::move(const std::queue<Vector2>& path) {
-	//Logger::log("Actor " + _name + " chose new destination.");
-	if (!path.empty()) {
+void Movable::move(const Path& path) {
+	//LOG(LOG_DEBUG, LOG_ACTIONS, "Actor " + _name + " chose new destination.");
+	if (!path.isEmpty()) {
+		cancelPathRequest();
 		_path = path;
-		_lastDestination = path.empty() ? _position : path.back();
+		_lastDestination = path.getGoal();
 		_nextSafeGoal = getNextSafeGoal();
 	}
 	else {
@@ -353,8 +382,66 @@ void Movable::move(const std::queue<Vector2>& path) {
 	}
 }
 
+std::shared_ptr<PathRequest> Movable::moveTo(const Vector2& destination) {
+	abortMovement(true);
+	if (!checkMovementCollisions(getCollisionResolver(), this, Segment(_position, destination))) {
+		_path.push(destination);
+		_lastDestination = destination;
+		_nextSafeGoal = getNextSafeGoal();
+	}
+	requestPath(destination, {});
+	return _pathRequest;
+}
+
+void Movable::moveAlongFlowField(const Vector2& destination) {
+	abortMovement(true);
+	Game* game = Game::getInstance();
+	std::shared_ptr<const FlowField> field = game->getFlowFieldService()->acquire(destination);
+	Path path;
+	if (field != nullptr) {
+		path = game->getMap()->followFlowField(*field, _position, destination, this);
+	}
+	move(path);
+	if (!path.isEmpty()) {
+		_flowField = field;
+	}
+}
+
+void Movable::requestPath(const Vector2& destination, const std::vector<common::Circle>& ignoredAreas) {
+	cancelPathRequest();
+	_pathRequest = Game::getInstance()->getPathService()->request(_position, destination, getRadius(), ignoredAreas);
+}
+
+void Movable::recalculatePath(const Vector2& destination) {
+	common::Circle blockedArea(_position, 50.0f * (_recalculations + 1));
+	// cieka jest naprawiana przez usug planowania cieek z uyciem stanu D* Lite zachowanego
+	// od poprzednich prb, a wynik jest odbierany tak jak wynik zwykego zlecenia.
+	if (Config.IncrementalReplanning) {
+		Game* game = Game::getInstance();
+		if (_planner == nullptr) {
+			_planner = std::make_shared<IncrementalPlanner>(game->getMap(), IncrementalPlanner::NULL_IDX);
+		}
+		cancelPathRequest();
+		_pathRequest = game->getPathService()->requestRepair(_position, destination, getRadius(), blockedArea, _planner);
+	}
+	else {
+		requestPath(destination, { blockedArea });
+	}
+}
+
+void Movable::cancelPathRequest() {
+	if (_pathRequest != nullptr) {
+		_pathRequest->cancel();
+		_pathRequest = nullptr;
+	}
+}
+
+bool Movable::isAwaitingPath() const { return _pathRequest != nullptr; }
+
 void Movable::abortMovement(/*String loggerMessage, */bool resetCounter) {
-	_path = {};
+	cancelPathRequest();
+	_flowField = nullptr;
+	_path.clear();
 	_preferredVelocity = Vector2();
 	_velocity = Vector2();
 	_isWaiting = false;
@@ -364,9 +451,10 @@ void Movable::abortMovement(/*String loggerMessage, */bool resetCounter) {
 	_nextHistoryIdx = 0;
 	if (resetCounter) {
 		_recalculations = 0;
+		_planner = nullptr;
 	}
 	clearPositionHistory();
-	//Logger::log(loggerMessage);
+	//LOG(LOG_DEBUG, LOG_ACTIONS, loggerMessage);
 }
 
 void Movable::stop() {
@@ -377,21 +465,24 @@ void Movable::update(GameTime time) {
 	updateMovement(time);
 	updateOrientation(time);
 
+	// Przy wsadowej aktualizacji ruchu pooenie w strukturze kolizji uaktualnia MovementSystem.
 	CollisionResolver* collisionResolver = getCollisionResolver();
-	if (collisionResolver != nullptr && hasPositionChanged()) {
+	if (collisionResolver != nullptr && hasPositionChanged() && !isMovementBatched()) {
 		collisionResolver->update(this);
 	}
 }
 
-bool Movable::isMoving() const { return _path.size() > 0 || _preferredVelocity.lengthSquared() > common::EPSILON; }
+bool Movable::isMoving() const { 
+	return !_path.isEmpty() || _preferredVelocity.lengthSquared() > common::EPSILON || _pathRequest != nullptr;
+}
 
 bool Movable::isStrayingFromPath() const { return !_isStrictlyFollowingPath; }
 
 bool Movable::isRotating() const { return _isRotating; }
 
 void Movable::setPreferredVelocityAndSafeGoal() {
-	if (!_path.empty()) {
-		Vector2 goal = _path.back();
+	if (!_path.isEmpty()) {
+		Vector2 goal = _path.getGoal();
 		if (!checkMovementCollisions(getCollisionResolver(), this, Segment(_position, goal))) {
 			if (common::sqDist(_position, goal) < common::sqr(Config.MovementGoalMargin)) {
 				abortMovement(/*"Actor " + _name + " reached its destination.", */true);
@@ -403,10 +494,10 @@ void Movable::setPreferredVelocityAndSafeGoal() {
 		}
 		else {
 			if ((_nextSafeGoal - _position).lengthSquared() < common::sqr(Config.MovementGoalMargin)) {
-				_path.pop();
+				_path.advance();
 				_nextSafeGoal = getNextSafeGoal();
 			}
-			if (!_path.empty()) {
+			if (!_path.isEmpty()) {
 				_preferredVelocity = _nextSafeGoal - _position;
 				_isStrictlyFollowingPath = true;
 			}
@@ -433,100 +524,258 @@ Vector2 Movable::selectVelocity(const std::vector<Candidate>& candidates) const
 	return candidates[min].velocity;
 }
 
-std::vector<Spottable*> Movable::getObjectsInViewAngle() const {
-	float angle = common::radians(Config.ActorVOCheckAngle);
-	float from = _orientation - angle;
-	float to = _orientation + angle;
+// Parametry testu przynalenoci do stoka widzenia. Krawdzie stoka to odcinki dugoci range
+// wychodzce z pooenia obiektu w kierunkach side1 i side2 (side2 ley przeciwnie do ruchu wskazwek zegara).
+struct ViewCone {
+	Vector2 side1;
+	Vector2 side2;
+	bool isWide;
+	float range;
+	float sideDistanceSq;
+	float closeDistanceSq;
+};
+
+// Pooenia (wzgldem obiektu) i promienie ssiadw w ukadzie tablic, wsplne dla wywoa w danym wtku.
+struct ViewConeBuffers {
+	std::vector<float> x;
+	std::vector<float> y;
+	std::vector<float> radii;
+	std::vector<unsigned char> mask;
+};
+
+thread_local ViewConeBuffers viewConeBuffers;
+
+// Kwadrat odlegoci punktu (x, y) od odcinka o pocztku w (0, 0), kierunku side i dugoci range.
+inline float sqDistToConeSide(float x, float y, const Vector2& side, float range) {
+	float t = common::clamp(x * side.x + y * side.y, 0, range);
+	float dx = x - side.x * t, dy = y - side.y * t;
+	return dx * dx + dy * dy;
+}
 
-	float r = getRadius();
-	float safetyMargin = Config.MovementSafetyMargin;
-	float voCheckRadius = Config.ActorVOCheckRadius;
+// Wyznacza mask[i] dla n ssiadw. Ptla nie zawiera rozgazie zalenych od danych ani funkcji
+// trygonometrycznych: kt jest sprawdzany znakami iloczynw wektorowych z krawdziami stoka.
+void filterViewCone(const ViewCone& cone, const float* x, const float* y, const float* radii, size_t n, unsigned char* mask) {
+	for (size_t i = 0; i < n; ++i) {
+		float sqDist = x[i] * x[i] + y[i] * y[i];
+		float cross1 = cone.side1.x * y[i] - cone.side1.y * x[i];
+		float cross2 = x[i] * cone.side2.y - y[i] * cone.side2.x;
+		bool isInAngle = cone.isWide ? (cross1 >= 0) | (cross2 >= 0) : (cross1 >= 0) & (cross2 >= 0);
+		bool isNearSide = (sqDistToConeSide(x[i], y[i], cone.side1, cone.range) <= cone.sideDistanceSq)
+			| (sqDistToConeSide(x[i], y[i], cone.side2, cone.range) <= cone.sideDistanceSq);
+		bool isInRange = sqDist <= common::sqr(cone.range + radii[i]);
+		mask[i] = ((isInAngle | isNearSide) & isInRange) | (sqDist <= cone.closeDistanceSq);
+	}
+}
 
-	Segment fromSeg = Segment(_position, _position + Vector2(cosf(from), sinf(from)) * voCheckRadius);
-	Segment toSeg = Segment(_position, _position + Vector2(cosf(to), sinf(to)) * voCheckRadius);
-	//voCheckRadius *= voCheckRadius;
-	float temp = common::sqr(2 * r + common::EPSILON + safetyMargin + getMaxSpeed());
+ViewCone createViewCone(const Vector2& side1, const Vector2& side2, float radius, float maxSpeed) {
+	ViewCone cone;
+	cone.side1 = side1;
+	cone.side2 = side2;
+	cone.isWide = Config.ActorVOCheckAngle > 90;
+	cone.range = (float)Config.ActorVOCheckRadius;
+	cone.sideDistanceSq = common::sqr(radius);
+	cone.closeDistanceSq = common::sqr(2 * radius + common::EPSILON + Config.MovementSafetyMargin + maxSpeed);
+	return cone;
+}
+
+std::vector<Spottable*> Movable::getObjectsInViewAngle() const {
+	if (_orientation != _viewConeOrientation) {
+		float angle = common::radians(Config.ActorVOCheckAngle);
+		_viewConeSide1 = Vector2(cosf(_orientation - angle), sinf(_orientation - angle));
+		_viewConeSide2 = Vector2(cosf(_orientation + angle), sinf(_orientation + angle));
+		_viewConeOrientation = _orientation;
+	}
+	ViewCone cone = createViewCone(_viewConeSide1, _viewConeSide2, getRadius(), getMaxSpeed());
+
+	std::vector<Spottable*> spotted = getSpottedObjects();
+	size_t n = spotted.size();
+	ViewConeBuffers& buffers = viewConeBuffers;
+	buffers.x.resize(n);
+	buffers.y.resize(n);
+	buffers.radii.resize(n);
+	buffers.mask.resize(n);
+	for (size_t i = 0; i < n; ++i) {
+		Vector2 otherPos = spotted[i]->getPosition();
+		buffers.x[i] = otherPos.x - _position.x;
+		buffers.y[i] = otherPos.y - _position.y;
+		buffers.radii[i] = spotted[i]->getRadius();
+	}
+
+	filterViewCone(cone, buffers.x.data(), buffers.y.data(), buffers.radii.data(), n, buffers.mask.data());
 
 	std::vector<Spottable*> result;
-	for (Spottable* other : getSpottedObjects()) {
-		Vector2 otherPos = other->getPosition();
-		if (
-			(common::isAngleBetween(common::angleFromTo(_position, otherPos), from, to)
-				|| common::distance(otherPos, fromSeg) <= r || common::distance(otherPos, toSeg) <= r)
-			&& 
-			common::distance(otherPos, _position) - other->getRadius() <= voCheckRadius
-			|| common::sqDist(otherPos, _position) <= temp
-			) {
-			result.push_back(other);
+	for (size_t i = 0; i < n; ++i) {
+		if (buffers.mask[i]) {
+			result.push_back(spotted[i]);
 		}
 	}
 	return result;
 }
 
-void Movable::updateMovement(GameTime time) {
-	Spotter::update(time);
-	if (isMoving()) {
-		setPreferredVelocityAndSafeGoal();
-		_velocity = selectVelocity(computeCandidates(getVelocityObstacles(getObjectsInViewAngle())));
+#ifdef _DEBUG
+// Pierwotna implementacja testu, zachowana jako wzorzec dla benchmarkViewCone.
+bool isInViewAngleReference(const Vector2& position, float orientation, float r, float maxSpeed,
+	const Vector2& otherPos, float otherRadius) {
+	float angle = common::radians(Config.ActorVOCheckAngle);
+	float from = orientation - angle;
+	float to = orientation + angle;
+	float voCheckRadius = Config.ActorVOCheckRadius;
+
+	Segment fromSeg = Segment(position, position + Vector2(cosf(from), sinf(from)) * voCheckRadius);
+	Segment toSeg = Segment(position, position + Vector2(cosf(to), sinf(to)) * voCheckRadius);
+	float temp = common::sqr(2 * r + common::EPSILON + Config.MovementSafetyMargin + maxSpeed);
+
+	return (common::isAngleBetween(common::angleFromTo(position, otherPos), from, to)
+		|| common::distance(otherPos, fromSeg) <= r || common::distance(otherPos, toSeg) <= r)
+		&& common::distance(otherPos, position) - otherRadius <= voCheckRadius
+		|| common::sqDist(otherPos, position) <= temp;
+}
+
+void Movable::benchmarkViewCone(size_t samples) {
+	const size_t neighbors = 32;
+	float r = (float)Config.ActorRadius;
+	float maxSpeed = Config.ActorSpeed;
+	float extent = 1.5f * (Config.ActorVOCheckRadius + r);
+
+	std::vector<float> orientations(samples);
+	std::vector<float> x(samples * neighbors), y(samples * neighbors), radii(samples * neighbors, r);
+	for (size_t i = 0; i < samples; ++i) {
+		orientations[i] = Rng::getFloat(-common::PI_F, common::PI_F);
+		for (size_t j = 0; j < neighbors; ++j) {
+			x[i * neighbors + j] = Rng::getFloat(-extent, extent);
+			y[i * neighbors + j] = Rng::getFloat(-extent, extent);
+		}
+	}
 
-		if (_velocity.lengthSquared() > common::EPSILON) {
-			_velocity = _velocity.normal() * getMaxSpeed();
+	GameTime frequency = SDL_GetPerformanceFrequency();
+	GameTime from, referenceTime, coneTime;
+	std::vector<unsigned char> reference(samples * neighbors), mask(samples * neighbors);
+
+	from = SDL_GetPerformanceCounter();
+	for (size_t i = 0; i < samples; ++i) {
+		for (size_t j = 0; j < neighbors; ++j) {
+			size_t k = i * neighbors + j;
+			reference[k] = isInViewAngleReference(Vector2(), orientations[i], r, maxSpeed, Vector2(x[k], y[k]), radii[k]);
 		}
+	}
+	referenceTime = SDL_GetPerformanceCounter() - from;
 
-		MovementCheckResult movementCheckResult = checkMovement();
+	float angle = common::radians(Config.ActorVOCheckAngle);
+	from = SDL_GetPerformanceCounter();
+	for (size_t i = 0; i < samples; ++i) {
+		Vector2 side1(cosf(orientations[i] - angle), sinf(orientations[i] - angle));
+		Vector2 side2(cosf(orientations[i] + angle), sinf(orientations[i] + angle));
+		size_t k = i * neighbors;
+		filterViewCone(createViewCone(side1, side2, r, maxSpeed), &x[k], &y[k], &radii[k], neighbors, &mask[k]);
+	}
+	coneTime = SDL_GetPerformanceCounter() - from;
 
-		bool oscilationDetected = isOscilating();
-		if (movementCheckResult.allowed && !oscilationDetected) {
-			_position += _velocity;
-			saveCurrentPositionInHistory();
-			_isWaiting = false;
+	size_t mismatches = 0, accepted = 0;
+	for (size_t k = 0; k < samples * neighbors; ++k) {
+		if (reference[k] != mask[k]) { ++mismatches; }
+		if (mask[k]) { ++accepted; }
+	}
+
+	std::cout << "View cone benchmark (" << samples << " actors, " << neighbors << " neighbors each):\n"
+		<< "  atan2 test: " << referenceTime * 1000000 / frequency << " us\n"
+		<< "  cross product test: " << coneTime * 1000000 / frequency << " us\n"
+		<< "  accepted: " << accepted << ", mismatches: " << mismatches << "\n";
+}
+#endif
 
-			if (isLookingStraight() && _velocity.lengthSquared() > common::EPSILON) {
-				_desiredOrientation = common::angle(_velocity);
-				_isRotating = true;
+void Movable::updateMovement(GameTime time) {
+	if (isMovementBatched()) { return; }
+
+	if (prepareMovement(time)) {
+		if (Config.SteeringMode == "ORCA") {
+			_velocity = computeOrcaVelocity();
+		}
+		else {
+			_velocity = selectVelocity(computeCandidates(getVelocityObstacles(getObjectsInViewAngle())));
+
+			if (_velocity.lengthSquared() > common::EPSILON) {
+				_velocity = _velocity.normal() * getMaxSpeed();
 			}
+		}
+		finishMovement(checkMovement(), time);
+	}
+	else {
+		CollisionInvoker::invokeCollision(findResponders(_position), time);
+	}
+}
+
+bool Movable::isMovementBatched() const { return Game::getInstance()->getMovementSystem() != nullptr; }
+
+bool Movable::prepareMovement(GameTime time) {
+	Spotter::update(time);
 
-			CollisionInvoker::invokeCollision(movementCheckResult.responders, time);
+	if (_pathRequest != nullptr && _pathRequest->isReady()) {
+		std::shared_ptr<PathRequest> request = _pathRequest;
+		_pathRequest = nullptr;
+		if (!request->isCancelled()) {
+			move(request->getPath());
 		}
-		else if (_isWaiting || oscilationDetected) {
-			if (time - _waitingStarted > (_recalculations > 0 ? Config.MaxRecalculatedWaitingTime : Config.MaxMovementWaitingTime)) {
-				if (!_path.empty()) {
-					Vector2 destination = _path.back();
-					abortMovement(false);
-					if (_recalculations < Config.MaxRecalculations) {
-						++_recalculations;
-						move(Game::getInstance()->getMap()->findPath(_position, destination, this, {
-							common::Circle(_position, 50 * (_recalculations + 1))
-							}));
-					}
-				}
-				else {
-					stop();
+	}
+
+	// Bez cieki tymczasowej obiekt oczekuje w miejscu na wynik planowania.
+	if (isMoving() && (_pathRequest == nullptr || !_path.isEmpty())) {
+		setPreferredVelocityAndSafeGoal();
+		return true;
+	}
+	return false;
+}
+
+void Movable::finishMovement(const MovementCheckResult& movementCheckResult, GameTime time) {
+	bool oscilationDetected = isOscilating();
+	if (movementCheckResult.allowed && !oscilationDetected) {
+		_position += _velocity;
+		saveCurrentPositionInHistory();
+		_isWaiting = false;
+
+		if (isLookingStraight() && _velocity.lengthSquared() > common::EPSILON) {
+			_desiredOrientation = common::angle(_velocity);
+			_isRotating = true;
+		}
+
+		CollisionInvoker::invokeCollision(movementCheckResult.responders, time);
+	}
+	else if (_isWaiting || oscilationDetected) {
+		if (time - _waitingStarted > (_recalculations > 0 ? Config.MaxRecalculatedWaitingTime : Config.MaxMovementWaitingTime)) {
+			if (!_path.isEmpty()) {
+				Vector2 destination = _path.getGoal();
+				abortMovement(false);
+				if (_recalculations < Config.MaxRecalculations) {
+					++_recalculations;
+					recalculatePath(destination);
 				}
 			}
-		}
-		else {
-			_isWaiting = true;
-			_waitingStarted = time;
-			_velocity.x = 0;
-			_velocity.y = 0;
+			else {
+				stop();
+			}
 		}
 	}
 	else {
-		std::vector<CollisionResponder*> responders;
-		float r = getRadius();
-		auto potentialColliders = getDynamicObjectsInArea(getCollisionResolver(), _position, r);
-		common::Circle selfCircle = { _position, r };
-		for (DynamicEntity* t : potentialColliders) {
-			if (t != this && common::testCircles(selfCircle, { t->getPosition(), t->getRadius() })) {
-				CollisionResponder* resp = dynamic_cast<CollisionResponder*>(t);
-				if (resp != nullptr) {
-					responders.push_back(resp);
-				}
+		_isWaiting = true;
+		_waitingStarted = time;
+		_velocity.x = 0;
+		_velocity.y = 0;
+	}
+}
+
+std::vector<CollisionResponder*> Movable::findResponders(const Vector2& position) const {
+	std::vector<CollisionResponder*> responders;
+	float r = getRadius();
+	auto potentialColliders = getDynamicObjectsInArea(getCollisionResolver(), position, r);
+	common::Circle selfCircle = { position, r };
+	for (DynamicEntity* t : potentialColliders) {
+		if (t != this && common::testCircles(selfCircle, { t->getPosition(), t->getRadius() })) {
+			CollisionResponder* resp = dynamic_cast<CollisionResponder*>(t);
+			if (resp != nullptr) {
+				responders.push_back(resp);
 			}
 		}
-		CollisionInvoker::invokeCollision(responders, time);
 	}
+	return responders;
 }
 
 void Movable::saveCurrentPositionInHistory() {
@@ -550,7 +799,7 @@ bool Movable::isOscilating() const {
 				return false;
 			}
 		}
-		//Logger::log("Oscilation detected!");
+		//LOG(LOG_DEBUG, LOG_ACTIONS, "Oscilation detected!");
 		return true;
 	}
 	return false;
@@ -1,15 +1,20 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <queue>
 #include "entities/Entity.h"
 #include "engine/RegularGrid.h"
+#include "engine/Path.h"
 
 class CollisionResolver;
 class Wall;
 class CollisionInvoker;
 class Spotter;
 class DynamicEntity;
+class PathRequest;
+class IncrementalPlanner;
+class FlowField;
 
 struct VelocityObstacle {
 	Vector2 apex;
@@ -44,9 +49,16 @@ public:
 	bool isRotating() const;
 	bool isSpotting() const override;
 	bool isStrayingFromPath() const;
+	bool isAwaitingPath() const;
 
 	void lookAt(const Vector2& point);
-	void move(const std::queue<Vector2>& path);
+	void move(const Path& path);
+	// Zleca wyznaczenie cieki usudze planowania. Do czasu otrzymania wyniku obiekt porusza si
+	// bezporednio w stron celu, o ile odcinek nie przecina cian, a w przeciwnym razie czeka.
+	std::shared_ptr<PathRequest> moveTo(const Vector2& destination);
+	// Wyznacza ciek na podstawie pola kierunkw wspdzielonego z innymi obiektami zmierzajcymi
+	// do tego samego celu. Pole jest zwalniane po zakoczeniu lub przerwaniu ruchu.
+	void moveAlongFlowField(const Vector2& destination);
 	void stop();
 
 	virtual float getMaxSpeed() const = 0;
@@ -58,8 +70,9 @@ public:
 	Vector2 getLongGoal()  const;
 	Vector2 getPreferredVelocity() const;
 	void    setPreferredVelocity(const Vector2& velocity);
+	// Odlego do nastpnego punktu cieki powikszona o dugo jej pozostaej czci.
 	float   estimateRemainingDistance() const;
-	std::queue<Vector2> getCurrentPath() const;
+	const Path& getCurrentPath() const;
 
 	void update(GameTime time) override;
 	bool hasPositionChanged() const override;
@@ -73,14 +86,27 @@ protected:
 
 private:
 	void updateMovement(GameTime time);
+	bool isMovementBatched() const;
+	// Etapy aktualizacji ruchu: wybr prdkoci preferowanej (zwraca false, jeeli obiekt stoi w miejscu)
+	// oraz zastosowanie prdkoci wybranej i sprawdzonej przez updateMovement lub MovementSystem.
+	bool prepareMovement(GameTime time);
+	void finishMovement(const MovementCheckResult& movementCheckResult, GameTime time);
+	std::vector<CollisionResponder*> findResponders(const Vector2& position) const;
 	bool updateOrientation(GameTime time);
 public:
 	float calculateRotation() const;
 	Vector2 selectVelocity(const std::vector<Candidate>& candidates) const;
 	std::vector<Spottable*> getObjectsInViewAngle() const;
+#ifdef _DEBUG
+	// Porwnuje wyniki i czas dziaania biecego oraz pierwotnego (opartego na atan2) testu stoka widzenia.
+	static void benchmarkViewCone(size_t samples);
+#endif
 	MovementCheckResult checkMovement() const;
 	std::vector<Candidate> computeCandidates(const std::vector<VelocityObstacle>& vo) const;
 	std::vector<VelocityObstacle> getVelocityObstacles(const std::vector<Spottable*>& obstacles) const;
+	// Prdko wyznaczona metod ORCA (Config.SteeringMode == "ORCA") na podstawie jednokrotnie
+	// pobranego zbioru ssiadw i cian w otoczeniu obiektu.
+	Vector2 computeOrcaVelocity() const;
 
 	float minDistanceWithoutCollision(const Vector2& direction, float maxDistance) const;
 	std::pair<Vector2, Vector2> getVOSides(const Vector2& point, const common::Circle& circle) const;
@@ -88,6 +114,9 @@ public:
 	Vector2 getNextSafeGoal() const;
 	float getDistanceToGoal() const;
 	void abortMovement(bool resetCounter);
+	void requestPath(const Vector2& destination, const std::vector<common::Circle>& ignoredAreas);
+	void recalculatePath(const Vector2& destination);
+	void cancelPathRequest();
 	void setPreferredVelocityAndSafeGoal();
 
 	void saveCurrentPositionInHistory();
@@ -96,9 +125,18 @@ public:
 	Vector2 _velocity;
 	float _rotation;
 	Vector2 _preferredVelocity;
-	std::queue<Vector2> _path;
+	Path _path;
+	std::shared_ptr<PathRequest> _pathRequest;
+	// Stan wyszukiwania D* Lite zachowywany midzy kolejnymi prbami ominicia przeszkody,
+	// wspdzielony ze zleceniem naprawy cieki do czasu jego przetworzenia.
+	std::shared_ptr<IncrementalPlanner> _planner;
+	std::shared_ptr<const FlowField> _flowField;
 	Vector2 _lastDestination;
 	Vector2 _nextSafeGoal;
+	// Kierunki krawdzi stoka widzenia wyznaczone dla orientacji _viewConeOrientation.
+	mutable float _viewConeOrientation;
+	mutable Vector2 _viewConeSide1;
+	mutable Vector2 _viewConeSide2;
 
 	bool _isRotating;
 	bool _isStrictlyFollowingPath = false;
@@ -116,4 +154,5 @@ private:
 	RegularGrid::Region* _gridRegion = nullptr;
 
 	friend class RegularGrid;
+	friend class MovementSystem;
 };
\ No newline at end of file
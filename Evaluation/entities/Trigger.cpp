@@ -68,24 +68,30 @@ TriggerType ArmorPack::getTriggerType() const { return TriggerType::ARMOR; }
 TriggerType MedPack::getTriggerType() const { return TriggerType::HEALTH; }
 
 AmmoPack::AmmoPack(const String& weaponName, const Vector2& position, const String& label)
-	: Trigger(position, label), _weaponName(weaponName) {}
+	: Trigger(position, label), _weaponName(weaponName), _weaponId(MissileManager::NULL_WEAPON_ID) {}
 ArmorPack::ArmorPack(const Vector2& position, const String& label) : Trigger(position, label) {}
 MedPack::MedPack(const Vector2& position, const String& label) : Trigger(position, label) {}
 
 void AmmoPack::pick(Actor* actor, GameTime time) {
-	int currentAmmo = actor->getWeaponState(_weaponName).ammo;
-	auto weaponInfo = getWeaponInfo(_weaponName);
+	// Wyzwalacze mapy tworzone s przed wczytaniem opisw broni, wic identyfikator broni
+	// wyznaczany jest przy pierwszym podniesieniu.
+	if (_weaponId == MissileManager::NULL_WEAPON_ID) {
+		_weaponId = MissileManager::getWeaponId(_weaponName);
+		if (_weaponId == MissileManager::NULL_WEAPON_ID) { return; }
+	}
+	int currentAmmo = actor->getWeaponState(_weaponId).ammo;
+	const WeaponInfo& weaponInfo = MissileManager::getWeaponInfo(_weaponId);
 	int newAmmo = currentAmmo + weaponInfo.packAmmo > weaponInfo.maxAmmo ?
 		weaponInfo.maxAmmo : currentAmmo + weaponInfo.packAmmo;
-	actor->setAmmo(_weaponName, newAmmo);
+	actor->setAmmo(_weaponId, newAmmo);
 	newAmmo -= currentAmmo;
 	if (newAmmo > 0) {
-		Logger::log("Actor " + actor->getName() + " picked "
+		LOG(LOG_INFO, LOG_TRIGGERS, "Actor " + actor->getName() + " picked "
 			+ std::to_string(newAmmo) + " ammo for "
 			+ weaponInfo.name + ".");
 	}
 	else {
-		Logger::log("Aktor " + actor->getName() + " ammo for "
+		LOG(LOG_INFO, LOG_TRIGGERS, "Aktor " + actor->getName() + " ammo for "
 			+ weaponInfo.name + ".");
 	}
 }
@@ -95,20 +101,20 @@ void ArmorPack::pick(Actor* actor, GameTime time) {
 	if (shots == 0) {
 		actor->setArmor(Config.ArmorTriggerBonus);
 		actor->setRemainingArmorShots(Config.ArmorMaxShots);
-		Logger::log("Actor " + actor->getName()
+		LOG(LOG_INFO, LOG_TRIGGERS, "Actor " + actor->getName()
 			+ " gained armor bonus +"
 			+ std::to_string(Config.ArmorTriggerBonus) + ".");
 	}
 	else if (Config.ArmorMaxShots) {
 		float armor = common::min(actor->getArmor() * (1 + Config.ArmorTriggerMultiplier), Config.MaxArmor);
 		actor->setArmor(armor);
-		Logger::log("Actor " + actor->getName()
+		LOG(LOG_INFO, LOG_TRIGGERS, "Actor " + actor->getName()
 			+ " armor rose. Current armor: +"
 			+ std::to_string(armor) + ".");
 	}
 	else {
 		actor->setRemainingArmorShots(Config.ArmorMaxShots);
-		Logger::log("Actor " + actor->getName() + "'s armor was renewed.");
+		LOG(LOG_INFO, LOG_TRIGGERS, "Actor " + actor->getName() + "'s armor was renewed.");
 	}
 }
 
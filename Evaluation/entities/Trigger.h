@@ -67,6 +67,8 @@ public:
 
 private:
 	String _weaponName;
+	// NULL_WEAPON_ID do czasu pierwszego podniesienia.
+	int _weaponId;
 };
 
 
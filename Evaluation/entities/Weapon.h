@@ -12,11 +12,15 @@ enum WeaponLoadState {
 struct WeaponState {
 	int ammo;
 	GameTime lastShot;
+	// Chwila, po ktrej rozadowana bro zostanie ponownie zaadowana.
+	GameTime readyTime;
 	WeaponLoadState state;
 };
 
 struct WeaponInfo {
 	String name;
+	// Indeks w tablicy MissileManager::getWeaponInfo(int), nadawany po wczytaniu wszystkich broni.
+	int id;
 	int maxAmmo;
 	int initialAmmo;
 	int packAmmo;
@@ -2,6 +2,31 @@
 #include "main/Game.h"
 
 int main(int argc, char** argv) {	
+	// Generowanie pocze siatki nawigacji: Evaluation --generate-connections <plik wejciowy> <plik wyjciowy>
+	if (argc > 3 && String(argv[1]) == "--generate-connections") {
+		try {
+			GameMap::generateConnections(argv[2], argv[3]);
+		}
+		catch (const String& message) {
+			std::cerr << message << "\n";
+			return 1;
+		}
+		return 0;
+	}
+
+	// Kompilacja mapy do formatu binarnego: Evaluation --compile-map <plik mapy> [plik wyjciowy]
+	if (argc > 2 && String(argv[1]) == "--compile-map") {
+		String output = argc > 3 ? String(argv[3]) : String(argv[2]) + GameMap::COMPILED_MAP_EXTENSION;
+		try {
+			GameMap::compile(argv[2], output);
+		}
+		catch (const String& message) {
+			std::cerr << message << "\n";
+			return 1;
+		}
+		return 0;
+	}
+
 	auto frequency = SDL_GetPerformanceFrequency();
 	GameTime preferredFrameDuration = frequency / Config.FPS;
 	GameTime initialFrame;
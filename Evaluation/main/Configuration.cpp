@@ -46,6 +46,7 @@ ConfigurationParameters::ConfigurationParameters(const std::map<String, String>&
 	DefaultSettings(parameters.at("DefaultSettings")),
 	WeaponsDataFile(parameters.at("WeaponsDataFile")),
 	CollisionResolver(parameters.at("CollisionResolver")),
+	SteeringMode(parameters.at("SteeringMode")),
 	MedPackTexture(parameters.at("MedPackTexture")),
 	AmmoPackTexture(parameters.at("AmmoPackTexture")),
 	ArmorPackTexture(parameters.at("ArmorPackTexture")),
@@ -58,6 +59,8 @@ ConfigurationParameters::ConfigurationParameters(const std::map<String, String>&
 
 	StopIfOneTeamRemaining(readAsBool(parameters.at("StopIfOneTeamRemaining"))),
 	MultithreadingEnabled(readAsBool(parameters.at("MultithreadingEnabled"))),
+	IncrementalReplanning(readAsBool(parameters.at("IncrementalReplanning"))),
+	BatchedMovement(readAsBool(parameters.at("BatchedMovement"))),
 	ShowFpsCounter(readAsBool(parameters.at("ShowFpsCounter"))),
 	ShowTimer(readAsBool(parameters.at("ShowTimer"))),
 	ShowTeamsHealth(readAsBool(parameters.at("ShowTeamsHealth"))),
@@ -79,6 +82,16 @@ ConfigurationParameters::ConfigurationParameters(const std::map<String, String>&
 	WeaponChangeTime(readAsInt(parameters.at("WeaponChangeTime"))),
 	ActorDyingTime(readAsInt(parameters.at("ActorDyingTime"))),
 	MaxRecalculations(readAsInt(parameters.at("MaxRecalculations"))),
+	NextHopTableMaxNodes(readAsInt(parameters.at("NextHopTableMaxNodes"))),
+	PathCacheSize(readAsInt(parameters.at("PathCacheSize"))),
+	HierarchicalPathfindingMinNodes(readAsInt(parameters.at("HierarchicalPathfindingMinNodes"))),
+	PathServiceThreads(readAsInt(parameters.at("PathServiceThreads"))),
+	MovementThreads(readAsInt(parameters.at("MovementThreads"))),
+	MissileThreads(readAsInt(parameters.at("MissileThreads"))),
+	LogLevelMask(readAsInt(parameters.at("LogLevelMask"))),
+	LogCategoryMask(readAsInt(parameters.at("LogCategoryMask"))),
+	LogBinary(readAsBool(parameters.at("LogBinary"))),
+	LogOutput(parameters.at("LogOutput")),
 	HealthBarWidth(readAsInt(parameters.at("HealthBarWidth"))),
 	HealthBarHeight(readAsInt(parameters.at("HealthBarHeight"))),
 	ArmorMaxShots(readAsInt(parameters.at("ArmorMaxShots"))),
@@ -91,6 +104,8 @@ ConfigurationParameters::ConfigurationParameters(const std::map<String, String>&
 	TimerPosition(readAsInt(parameters.at("TimerPosition"))),
 
 	VOSideVelocityMargin(readAsFloat(parameters.at("VOSideVelocityMargin"))),	
+	OrcaTimeHorizon(readAsFloat(parameters.at("OrcaTimeHorizon"))),
+	OrcaObstacleTimeHorizon(readAsFloat(parameters.at("OrcaObstacleTimeHorizon"))),
 	ActorOscilationRadius(readAsFloat(parameters.at("ActorOscilationRadius"))),
 	TriggerRotationSpeed(readAsFloat(parameters.at("TriggerRotationSpeed"))),
 	ActorRotationSpeed(readAsFloat(parameters.at("ActorRotationSpeed"))),
@@ -105,9 +120,11 @@ ConfigurationParameters::ConfigurationParameters(const std::map<String, String>&
 	MedpackHealthBonus(readAsFloat(parameters.at("MedpackHealthBonus"))),
 	MaxArmor(readAsFloat(parameters.at("MaxArmor"))),
 	AabbTreeMargin(readAsFloat(parameters.at("AabbTreeMargin"))),
+	HierarchicalClusterSize(readAsFloat(parameters.at("HierarchicalClusterSize"))),
 	
 	MaxMovementWaitingTime(readAsTime(parameters.at("MaxMovementWaitingTime"))),
 	MaxRecalculatedWaitingTime(readAsTime(parameters.at("MaxRecalculatedWaitingTime"))),
+	FlowFieldExpiryTime(readAsTime(parameters.at("FlowFieldExpiryTime"))),
 	MinInitialTriggerActivationTime(readAsTime(parameters.at("MinInitialTriggerActivationTime"))),
 	MinTriggerActivationTime(readAsTime(parameters.at("MinTriggerActivationTime"))),
 	MaxTriggerActivationTime(readAsTime(parameters.at("MaxTriggerActivationTime"))),
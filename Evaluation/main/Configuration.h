@@ -35,6 +35,8 @@ struct ConfigurationParameters {
 	const int ActorVOCheckRadius;
 	const int ActorVOCheckAngle;
 	const float VOSideVelocityMargin;
+	const float OrcaTimeHorizon;
+	const float OrcaObstacleTimeHorizon;
 	const int MissileInitialDistance;
 	const int MinInitialTriggerActivationTime;
 	const int MinTriggerActivationTime;
@@ -44,7 +46,21 @@ struct ConfigurationParameters {
 	const int ActorDyingTime;
 	const float MaxMovementWaitingTime;
 	const float MaxRecalculatedWaitingTime;
+	const float FlowFieldExpiryTime;
 	const int MaxRecalculations;
+	const bool IncrementalReplanning;
+	const int NextHopTableMaxNodes;
+	const int PathCacheSize;
+	const int HierarchicalPathfindingMinNodes;
+	const float HierarchicalClusterSize;
+	const int PathServiceThreads;
+	const bool BatchedMovement;
+	const int MovementThreads;
+	const int MissileThreads;
+	const int LogLevelMask;
+	const int LogCategoryMask;
+	const bool LogBinary;
+	const String LogOutput;
 	const size_t ActionPositionHistoryLength;
 	const size_t MaxNotifications;
 	const float ActorOscilationRadius;
@@ -77,6 +93,7 @@ struct ConfigurationParameters {
 	const String TriggerRingTextureKey;
 	const String TriggerRingTexturePath;
 	const String CollisionResolver;
+	const String SteeringMode;
 	const String MedPackTextureKey;
 	const String MedPackTexture;
 	const String AmmoPackTextureKey;
@@ -28,6 +28,9 @@ Game::Game() {
 	}
 	_instance = this;
 	_camera = nullptr;
+	_pathService = nullptr;
+	_flowFieldService = nullptr;
+	_movementSystem = nullptr;
 }
 
 Game::~Game() {
@@ -50,6 +53,12 @@ GameTime Game::getCurrentTime() { return _instance->_gameTime; }
 
 MissileManager* Game::getMissileManager() const { return _missileManager; }
 
+PathService* Game::getPathService() const { return _pathService; }
+
+FlowFieldService* Game::getFlowFieldService() const { return _flowFieldService; }
+
+MovementSystem* Game::getMovementSystem() const { return _movementSystem; }
+
 GameTime Game::getTime() const { return _gameTime; }
 
 GameMap* Game::getMap() const { return _gameMap; }
@@ -72,7 +81,7 @@ GameSettings loadActorsData(String actorsFilename) {
 	reader.open(actorsFilename);
 
 	if (reader.fail()) {
-		Logger::log("Plik '" + actorsFilename + "' nie istnieje, jest niedostpny lub uszkodzony.");
+		LOG(LOG_ERROR, LOG_RESOURCES, "Plik '" + actorsFilename + "' nie istnieje, jest niedostpny lub uszkodzony.");
 	}
 	else {
 		String name, script;
@@ -107,6 +116,8 @@ bool Game::initialize(const String& settingsFilename) {
 	else {
 		_isRunning = false;
 	}
+
+	Logger::initialize();
 	
 	auto settings = loadActorsData(settingsFilename);
 	
@@ -127,6 +138,19 @@ bool Game::initialize(const String& settingsFilename) {
 	//GameMap::generateConnections(settings.map, "gen_conn.txt");
 
 	_gameMap = GameMap::create(settings.map.c_str());
+	//_gameMap->benchmarkPathfinding(10000);
+	//GameMap::benchmarkHierarchicalPathfinding(1000);
+	//_gameMap->benchmarkIncrementalPlanning(Vector2(180, 362), 1000); // drzwi na mapie six_rooms.map (settings4.esf)
+	//_gameMap->benchmarkPathCache(10000);
+	//_gameMap->benchmarkFlowFields(200, 5);
+	//Movable::benchmarkViewCone(100000);
+
+	_pathService = new PathService(_gameMap, Config.PathServiceThreads);
+	_flowFieldService = new FlowFieldService(_gameMap);
+	// Przy wielowtkowoci agentw ruch jest aktualizowany przez ich wtki, poza gwn ptl.
+	if (Config.BatchedMovement && !Config.MultithreadingEnabled) {
+		_movementSystem = new MovementSystem(_gameMap->getCollisionResolver(), Config.MovementThreads);
+	}
 	
 	_missileManager = new MissileManager();
 	_missileManager->initialize(_gameMap);
@@ -360,6 +384,9 @@ void Game::handleEvents() {
 		case SDL_QUIT:
 			_isRunning = false;
 			break;
+		case SDL_RENDER_TARGETS_RESET:
+			_isWallsLayerValid = false;
+			break;
 		default: break;
 		}
 	}
@@ -367,9 +394,28 @@ void Game::handleEvents() {
 
 
 void Game::dispose() {
+	GameMap::PathSmoothingStatistics statistics = _gameMap->getPathSmoothingStatistics();
+	if (statistics.paths > 0) {
+		LOG(LOG_DEBUG, LOG_PERFORMANCE, "Smoothed paths: " + std::to_string(statistics.paths)
+			+ ", waypoints: " + std::to_string(statistics.rawWaypoints) + " -> " + std::to_string(statistics.smoothedWaypoints)
+			+ ", total length: " + std::to_string(statistics.rawLength) + " -> " + std::to_string(statistics.smoothedLength));
+	}
+	size_t cacheHits = _gameMap->getPathCacheHits(), cacheMisses = _gameMap->getPathCacheMisses();
+	if (cacheHits + cacheMisses > 0) {
+		LOG(LOG_DEBUG, LOG_PERFORMANCE, "Path cache hits: " + std::to_string(cacheHits) + ", misses: " + std::to_string(cacheMisses)
+			+ ", hit rate: " + std::to_string(100.0 * cacheHits / (cacheHits + cacheMisses)) + "%");
+	}
 	delete _missileManager;
+	delete _pathService;
+	_pathService = nullptr;
+	delete _flowFieldService;
+	_flowFieldService = nullptr;
+	delete _movementSystem;
+	_movementSystem = nullptr;
 	GameMap::destroy(_gameMap);
+	disposeWallsLayer();
 	ResourceManager::dispose();
+	Logger::dispose();
 	SDL_DestroyRenderer(_renderer);
 	SDL_DestroyWindow(_window);
 	SDL_Quit();
@@ -395,7 +441,7 @@ void Game::update(GameTime time) {
 				agentsTotalFrames[agent] = newTotalFrames;
 			}
 			
-			Logger::log("Remaining time: " + std::to_string(_lastTimeVisible) + "s");
+			LOG(LOG_INFO, LOG_GENERAL, "Remaining time: " + std::to_string(_lastTimeVisible) + "s");
 		}
 		else {
 			++_fps;
@@ -417,9 +463,13 @@ void Game::update(GameTime time) {
 				for (Agent* agent : _agents) {
 					agent->update(_gameTime);
 				}
+				if (_movementSystem != nullptr) {
+					_movementSystem->update(getActors(), _gameTime);
+				}
 			}
 
 			_missileManager->update(_gameTime);
+			_flowFieldService->collect(_gameTime);
 
 			while (!_threadsToDispose.empty()) {
 				Agent* agent = _threadsToDispose.front();
@@ -465,8 +515,6 @@ void Game::update(GameTime time) {
 			_isUpdateEnabled = false;
 		}		
 
-		Logger::printLogs();
-		Logger::clear();
 	}
 }
 
@@ -482,6 +530,13 @@ void Game::render() const {
 	SDL_SetRenderDrawColor(_renderer, 128, 144, 192, 255);
 	SDL_RenderClear(_renderer);
 
+	// Obiekty s odrzucane wzgldem rzeczywistego obszaru renderowania, ktry moe by wikszy
+	// od rozmiaru okna podanego w konfiguracji.
+	int outputWidth, outputHeight;
+	if (SDL_GetRendererOutputSize(_renderer, &outputWidth, &outputHeight) == 0) {
+		_camera->setViewSize(outputWidth, outputHeight);
+	}
+
 	Vector2 center = Vector2(Config.DisplayWidth / 2, Config.DisplayHeight / 2);
 	Vector2 mousePos = Vector2(mousePosX, mousePosY);
 	Segment centerMouseSegment = Segment(center, mousePos);
@@ -490,11 +545,12 @@ void Game::render() const {
 
 	if (_isNavigationMeshVisible) {
 		for (Segment arc : _gameMap->getNavigationArcs()) {
-			drawSegment(_renderer, arc, *_camera, colors::blue);
+			_primitives.addSegment(arc, *_camera, colors::blue);
 		}
 		for (Vector2 point : _gameMap->getNavigationNodes()) {
-			drawPoint(_renderer, point, *_camera, colors::blue);
+			_primitives.addPoint(point, *_camera, colors::blue);
 		}
+		_primitives.flush(_renderer);
 	}
 
 	if (_areAabbsVisible) {
@@ -547,24 +603,23 @@ void Game::render() const {
 		if (currentActor->isStrayingFromPath()) {
 			Vector2 pos = currentActor->getPosition(); 
 			Vector2 goal = currentActor->getLongGoal();
-			drawSegment(_renderer, Segment(pos, goal), *_camera, colors::yellow);
-			drawPoint(_renderer, goal, *_camera, colors::yellow);
+			_primitives.addSegment(Segment(pos, goal), *_camera, colors::yellow);
+			_primitives.addPoint(goal, *_camera, colors::yellow);
 		}
 		else {
-			auto pathCopy = std::queue<Vector2>(currentActor->getCurrentPath());
-			if (pathCopy.size() > 0) {
+			const Path& path = currentActor->getCurrentPath();
+			if (!path.isEmpty()) {
 				Vector2 prev = currentActor->getPosition();
-				drawPoint(_renderer, prev, *_camera, colors::yellow);
-				while (!pathCopy.empty()) {
-					Vector2 next = pathCopy.front();
-					pathCopy.pop();
-					drawSegment(_renderer, Segment(prev, next), *_camera, colors::yellow);
-					drawPoint(_renderer, next, *_camera, colors::yellow);
+				_primitives.addPoint(prev, *_camera, colors::yellow);
+				for (const Vector2& next : path) {
+					_primitives.addSegment(Segment(prev, next), *_camera, colors::yellow);
+					_primitives.addPoint(next, *_camera, colors::yellow);
 					prev = next;
 				}
 			}
 		}
 	}
+	_primitives.flush(_renderer);
 
 #endif
 
@@ -586,20 +641,28 @@ void Game::render() const {
 	}
 	*/
 
-	auto walls = _gameMap->getWalls();
-	for (StaticEntity* wall : walls) {
-		//drawSegment(common::extendSegment(wall, Aabb(0, 0, DisplayWidth, DisplayHeight)), gray);
-		for (Segment segment : wall->getBounds()) {
-			drawSegment(_renderer, segment, *_camera, colors::black);
+	renderWalls();
+
+	// Margines uwzgldnia napisy i paski zdrowia rysowane poza obrysem obiektu.
+	float labelMargin = Config.HealthBarWidth + Config.ActorNamePosition;
+
+	for (Trigger* trigger : _gameMap->getTriggers()) {
+		if (_camera->isVisible(trigger->getPosition(), Config.TriggerRadius + labelMargin)) {
+			drawTrigger(_renderer, *trigger, *_camera);
 		}
 	}
 
-	for (Trigger* trigger : _gameMap->getTriggers()) {
-		drawTrigger(_renderer, *trigger, *_camera);
+	std::vector<Actor*> visibleActors;
+	for (Actor* actor : _gameMap->getActors()) {
+		if (_camera->isVisible(actor->getPosition(), Config.ActorSelectionRing + labelMargin)) {
+			visibleActors.push_back(actor);
+			drawActorBody(_primitives, *actor, *_camera, _playerAgent != nullptr && _playerAgent->getActor() == actor);
+		}
 	}
+	_primitives.flush(_renderer);
 
-	for (Actor* actor : _gameMap->getActors()) {	
-		drawActor(_renderer, *actor, *_camera, _playerAgent != nullptr && _playerAgent->getActor() == actor, _areHealthBarsVisible);
+	for (Actor* actor : visibleActors) {	
+		drawActor(_renderer, *actor, *_camera, _areHealthBarsVisible);
 	}
 
 //#ifdef _DEBUG
@@ -635,14 +698,19 @@ void Game::render() const {
 //
 //#endif // _DEBUG
 	
-	SDL_Color missileColor;
-	for (Missile& missile : _missileManager->getMissiles()) {		
-		drawSegment(_renderer, Segment(missile.frontPosition, missile.backPosition), *_camera, getWeaponInfo(missile.weaponType).color);
+	for (Missile& missile : _missileManager->getMissiles()) {
+		Segment segment(missile.frontPosition, missile.backPosition);
+		if (_camera->isVisible(segment)) {
+			_primitives.addSegment(segment, *_camera, MissileManager::getWeaponInfo(missile.weaponId).color);
+		}
 	}
 
 	for (common::Ring& ring : _missileManager->getExplosions(_gameTime)) {
-		fillRing(_renderer, ring.center, ring.radius1, ring.radius2, *_camera, colors::red);
+		if (_camera->isVisible(ring.center, common::max(ring.radius1, ring.radius2))) {
+			_primitives.addRing(ring.center, ring.radius1, ring.radius2, *_camera, colors::red);
+		}
 	}
+	_primitives.flush(_renderer);
 	
 	if (Config.ShowTimer) {
 		size_t seconds = getRemainingTime();
@@ -670,6 +738,54 @@ void Game::render() const {
 	SDL_RenderPresent(_renderer);
 }
 
+void Game::renderWalls() const {
+	SDL_Rect area = { _camera->getX(), _camera->getY(), _camera->getViewWidth(), _camera->getViewHeight() };
+
+	if (_wallsLayer == nullptr || area.w != _wallsLayerArea.w || area.h != _wallsLayerArea.h) {
+		if (_wallsLayer != nullptr) { SDL_DestroyTexture(_wallsLayer); }
+		_wallsLayer = SDL_RenderTargetSupported(_renderer)
+			? SDL_CreateTexture(_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, area.w, area.h)
+			: nullptr;
+		if (_wallsLayer != nullptr) { SDL_SetTextureBlendMode(_wallsLayer, SDL_BLENDMODE_BLEND); }
+		_isWallsLayerValid = false;
+	}
+
+	if (_wallsLayer == nullptr) {
+		drawWalls();
+		return;
+	}
+
+	if (!_isWallsLayerValid || area.x != _wallsLayerArea.x || area.y != _wallsLayerArea.y) {
+		SDL_SetRenderTarget(_renderer, _wallsLayer);
+		SDL_SetRenderDrawColor(_renderer, 0, 0, 0, 0);
+		SDL_RenderClear(_renderer);
+		drawWalls();
+		SDL_SetRenderTarget(_renderer, nullptr);
+		_wallsLayerArea = area;
+		_isWallsLayerValid = true;
+	}
+	SDL_RenderCopy(_renderer, _wallsLayer, nullptr, nullptr);
+}
+
+void Game::drawWalls() const {
+	for (StaticEntity* wall : _gameMap->getWalls()) {
+		for (Segment segment : wall->getBounds()) {
+			if (_camera->isVisible(segment)) {
+				_primitives.addSegment(segment, *_camera, colors::black);
+			}
+		}
+	}
+	_primitives.flush(_renderer);
+}
+
+void Game::disposeWallsLayer() {
+	if (_wallsLayer != nullptr) {
+		SDL_DestroyTexture(_wallsLayer);
+		_wallsLayer = nullptr;
+	}
+	_isWallsLayerValid = false;
+}
+
 void Game::registerAgentToDispose(Agent* agent) {
 	_threadsToDispose.push(agent);
 	Actor* actor = agent->getActor();
@@ -8,6 +8,9 @@
 #include "engine/SegmentTree.h"
 #include "engine/Navigation.h"
 #include "engine/MissileManager.h"
+#include "engine/PathService.h"
+#include "engine/FlowField.h"
+#include "engine/MovementSystem.h"
 #include "entities/Team.h"
 #include "entities/Trigger.h"
 #include "SDL.h"
@@ -15,6 +18,7 @@
 #include "agents/Agent.h"
 #include "agents/LuaEnvironment.h"
 #include "engine/Camera.h"
+#include "engine/PrimitiveBatch.h"
 
 enum GameState {
 	IN_PROGRESS,
@@ -51,6 +55,10 @@ public:
 	std::vector<Actor*> getActors() const;
 	std::vector<Trigger*> getTriggers() const;
 	MissileManager* getMissileManager() const;
+	PathService* getPathService() const;
+	FlowFieldService* getFlowFieldService() const;
+	// Zwraca nullptr, jeeli ruch aktorw jest aktualizowany indywidualnie.
+	MovementSystem* getMovementSystem() const;
 
 	void registerAgentToDispose(Agent* agent);
 	GameState checkWinLoseConditions(std::vector<Team*>& winners) const;
@@ -69,9 +77,13 @@ private:
 	SDL_Window* _window;
 	SDL_Renderer* _renderer;
 	Camera* _camera;
+	mutable PrimitiveBatch _primitives;
 	
 	GameMap* _gameMap;
 	MissileManager* _missileManager;
+	PathService* _pathService;
+	FlowFieldService* _flowFieldService;
+	MovementSystem* _movementSystem;
 	std::vector<Team*> _teams;
 
 	PlayerAgent* _playerAgent;
@@ -80,6 +92,16 @@ private:
 
 	void initializeTeams(const std::vector<ActorLoadedData>& actorsData);
 
+	// Warstwa ze cianami jest rysowana do tekstury i odwieana tylko po przesuniciu kamery
+	// lub zmianie rozmiaru obszaru renderowania.
+	mutable SDL_Texture* _wallsLayer = nullptr;
+	mutable SDL_Rect _wallsLayerArea = { 0, 0, 0, 0 };
+	mutable bool _isWallsLayerValid = false;
+
+	void renderWalls() const;
+	void drawWalls() const;
+	void disposeWallsLayer();
+
 	bool _areHealthBarsVisible = true;
 	bool _isNavigationMeshVisible = false;
 	bool _areAabbsVisible = false;